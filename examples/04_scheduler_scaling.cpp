@@ -0,0 +1,109 @@
+// Scaling benchmark of the work-stealing scheduler on a pricing-heavy workload:
+// a full reduced-cost scan of a large column store, as in every sifting iteration.
+// Usage: 04_scheduler_scaling [columns] [rows] [rounds]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../include/column_store.hpp"
+#include "../include/task_scheduler.hpp"
+
+int main(int argc, char** argv) {
+    const size_t numColumns = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+    const int numRows = argc > 2 ? std::atoi(argv[2]) : 500;
+    const int rounds = argc > 3 ? std::atoi(argv[3]) : 10;
+    const size_t grain = 16384;
+
+    try {
+        std::cout << "=== Scheduler Scaling Benchmark ===" << std::endl;
+
+        // 1. Random set-covering columns with 5-15 rows each
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> rowDist(0, numRows - 1);
+        std::uniform_int_distribution<int> lengthDist(5, 15);
+        ColumnStore store(numRows, true);
+        store.reserve(numColumns, numColumns * 10);
+        std::vector<int> rows;
+        for (size_t j = 0; j < numColumns; ++j) {
+            rows.clear();
+            const int length = lengthDist(rng);
+            for (int k = 0; k < length; ++k) {
+                rows.push_back(rowDist(rng));
+            }
+            std::sort(rows.begin(), rows.end());
+            rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+            store.addColumn(static_cast<double>(rows.size()) + 0.5, rows);
+        }
+        std::uniform_real_distribution<double> dualDist(0.0, 1.2);
+        std::vector<double> duals(numRows);
+        for (double& dual : duals) {
+            dual = dualDist(rng);
+        }
+
+        NumaTopology topology = NumaTopology::detect();
+        std::cout << "Columns " << store.size() << ", nonzeros " << store.getNumNonzeros()
+                  << ", NUMA nodes " << topology.getNumNodes()
+                  << ", CPUs " << topology.getNumCpus() << std::endl;
+
+        // 2. Scan with 1..64 threads; each chunk reports its most negative reduced cost.
+        // The caller executes chunks while it waits, so T threads are T - 1 workers plus
+        // the caller, and the single-thread baseline scans on the caller alone.
+        std::cout << std::setw(8) << "threads" << std::setw(12) << "seconds"
+                  << std::setw(10) << "speedup" << std::setw(12) << "efficiency"
+                  << std::setw(10) << "stolen" << std::endl;
+        double baseline = 0.0;
+        for (int threads = 1; threads <= 64; threads *= 2) {
+            std::unique_ptr<TaskScheduler> scheduler;
+            if (threads > 1) {
+                SchedulerParams params;
+                params.numThreads = threads - 1;
+                scheduler.reset(new TaskScheduler(params));
+            }
+
+            double best = std::numeric_limits<double>::infinity();
+            const auto start = std::chrono::steady_clock::now();
+            for (int round = 0; round < rounds; ++round) {
+                const size_t chunks = (store.size() + grain - 1) / grain;
+                std::vector<double> chunkMin(chunks, std::numeric_limits<double>::infinity());
+                auto scan = [&](size_t first, size_t last) {
+                    std::vector<double> buffer(grain);
+                    for (size_t chunk = first; chunk < last; ++chunk) {
+                        const size_t begin = chunk * grain;
+                        const size_t end = std::min(store.size(), begin + grain);
+                        store.reducedCosts(duals.data(), begin, end, buffer.data());
+                        chunkMin[chunk] = *std::min_element(buffer.begin(), buffer.begin() + (end - begin));
+                    }
+                };
+                if (scheduler) {
+                    scheduler->parallelFor(0, chunks, 1, scan, TaskPriority::High);
+                } else {
+                    scan(0, chunks);
+                }
+                best = std::min(best, *std::min_element(chunkMin.begin(), chunkMin.end()));
+            }
+            const double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+            if (threads == 1) {
+                baseline = seconds;
+            }
+
+            std::cout << std::setw(8) << threads
+                      << std::setw(12) << std::fixed << std::setprecision(4) << seconds
+                      << std::setw(10) << std::setprecision(2) << baseline / seconds
+                      << std::setw(12) << baseline / seconds / threads
+                      << std::setw(10) << (scheduler ? scheduler->getStats().stolen : 0)
+                      << "   (min rc " << std::setprecision(4) << best << ")" << std::endl;
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
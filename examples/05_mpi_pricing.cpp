@@ -0,0 +1,110 @@
+// Column generation with MPI-distributed pricing.
+// Rank 0 owns the master; every other rank prices a share of the subproblems.
+// Run locally with: mpirun -np 4 ./05_mpi_pricing [subproblems] [rows]
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../include/column_generation.hpp"
+#include "../include/column_store.hpp"
+#include "../include/mpi_pricing.hpp"
+
+namespace {
+
+// Subproblem k: a store of random covering columns (deterministic per k, so any rank
+// can build it)
+class StoreSubproblem : public PricingOracle {
+private:
+    ColumnStore store_;
+    ColumnStorePricer pricer_;
+    int index_;
+
+public:
+    StoreSubproblem(int index, int numRows)
+        : store_(numRows, true), pricer_(store_, 10), index_(index) {
+        std::mt19937 rng(1000 + index);
+        std::vector<int> rows;
+        for (int j = 0; j < 2000; ++j) {
+            rows.clear();
+            for (int i = 0; i < numRows; ++i) {
+                if (rng() % 5 == 0) {
+                    rows.push_back(i);
+                }
+            }
+            if (rows.empty()) {
+                rows.push_back(j % numRows);
+            }
+            store_.addColumn(1.0 + 0.6 * rows.size() + (rng() % 100) / 40.0, rows);
+        }
+    }
+
+    std::string getName() const override { return "store_" + std::to_string(index_); }
+    double price(const std::vector<double>& duals, std::vector<Column>& columns) override {
+        return pricer_.price(duals, columns);
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    const int numSubproblems = argc > 1 ? std::atoi(argv[1]) : 16;
+    const int numRows = argc > 2 ? std::atoi(argv[2]) : 30;
+    int status = 0;
+
+    try {
+        MpiPricing pricing(MPI_COMM_WORLD, numRows, numSubproblems,
+                           [&](int k) { return std::make_unique<StoreSubproblem>(k, numRows); },
+                           std::vector<double>(numSubproblems, numRows));
+
+        if (!pricing.isMaster()) {
+            pricing.serve();
+        } else {
+            std::cout << "=== MPI Pricing Example ===" << std::endl;
+
+            // Covering master with expensive artificial columns
+            ScipSolver master("mpi_master");
+            master.setColumnGenerationMode();
+            std::vector<ScipVariable> artificials;
+            std::vector<ScipConstraint> rows;
+            artificials.reserve(numRows);
+            rows.reserve(numRows);
+            std::vector<ScipConstraint*> rowPointers;
+            for (int i = 0; i < numRows; ++i) {
+                artificials.push_back(master.createVariable("art_" + std::to_string(i), 0.0,
+                                                            SCIPinfinity(master.get()), 1000.0));
+                rows.push_back(master.createConstraint("cover_" + std::to_string(i),
+                                                       {&artificials.back()}, {1.0},
+                                                       1.0, SCIPinfinity(master.get())));
+                rowPointers.push_back(&rows.back());
+            }
+
+            ColumnGeneration cg(master, rowPointers);
+            for (int k = 0; k < numSubproblems; ++k) {
+                cg.addOracle(&pricing.getOracle(k));
+            }
+            ColumnGenerationParams params;
+            params.verbose = true;
+            const ColumnGenerationStats stats = cg.run(params);
+            pricing.shutdown();
+
+            const MpiPricingStats& comm = pricing.getStats();
+            std::cout << "Master objective: " << stats.masterObjective << std::endl;
+            std::cout << "Lagrangian bound: " << stats.lagrangianBound << std::endl;
+            std::cout << "Iterations: " << stats.iterations
+                      << ", columns added: " << stats.columnsAdded << std::endl;
+            std::cout << "Pricing rounds: " << comm.rounds
+                      << ", columns received: " << comm.columnsReceived
+                      << ", bytes: " << comm.bytesReceived
+                      << ", rank 0 wait: " << comm.waitTime << " s" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        status = 1;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    MPI_Finalize();
+    return status;
+}
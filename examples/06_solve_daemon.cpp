@@ -0,0 +1,200 @@
+// Batch-solve daemon on a Unix domain socket.
+//   06_solve_daemon serve <socket> [solvers] [metrics file]
+//                                               run the daemon until a client sends "shutdown",
+//                                               optionally exporting Prometheus metrics
+//   06_solve_daemon submit <socket> <jobfile>   send a job file and print the replies
+//   06_solve_daemon bench <socket> [jobs]       send random knapsack and covering jobs,
+//                                               then print the daemon's stats line
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../include/solve_daemon.hpp"
+
+namespace {
+
+class Client {
+private:
+    int fd_;
+    std::string buffer_;
+
+public:
+    explicit Client(const std::string& path) : fd_(::socket(AF_UNIX, SOCK_STREAM, 0)) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        if (fd_ < 0 || ::connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            throw std::runtime_error("Cannot connect to " + path);
+        }
+    }
+    ~Client() { ::close(fd_); }
+
+    void send(const std::string& text) {
+        size_t sent = 0;
+        while (sent < text.size()) {
+            const ssize_t n = ::send(fd_, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                throw std::runtime_error("Daemon closed the connection");
+            }
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    std::string readLine() {
+        size_t newline;
+        while ((newline = buffer_.find('\n')) == std::string::npos) {
+            char chunk[4096];
+            const ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                throw std::runtime_error("Daemon closed the connection");
+            }
+            buffer_.append(chunk, static_cast<size_t>(n));
+        }
+        std::string line = buffer_.substr(0, newline);
+        buffer_.erase(0, newline + 1);
+        return line;
+    }
+};
+
+bool isFinal(const std::string& line) {
+    return line.rfind("done ", 0) == 0 || line.rfind("error ", 0) == 0
+           || line.rfind("rejected ", 0) == 0;
+}
+
+// 0-1 knapsack solved directly by SCIP
+std::string knapsackJob(int id, std::mt19937& rng) {
+    std::ostringstream job;
+    const int items = 30;
+    job << "job knap" << id << "\ntimelimit 10\nsense max\n";
+    std::ostringstream row;
+    row << "row capacity -inf " << 5 * items;
+    for (int i = 0; i < items; ++i) {
+        job << "var x" << i << " 0 1 " << 1 + rng() % 50 << " int\n";
+        row << " x" << i << ":" << 1 + rng() % 20;
+    }
+    job << row.str() << "\nend\n";
+    return job.str();
+}
+
+// Covering LP whose columns are priced by column generation
+std::string coveringJob(int id, std::mt19937& rng) {
+    std::ostringstream job;
+    const int rows = 20;
+    job << "job cover" << id << "\ntimelimit 10\npricing max_columns=20\n";
+    for (int i = 0; i < rows; ++i) {
+        job << "var art" << i << " 0 inf 1000\n";
+        job << "row r" << i << " 1 inf art" << i << ":1\n";
+    }
+    for (int j = 0; j < 500; ++j) {
+        int count = 0;
+        std::ostringstream entries;
+        for (int i = 0; i < rows; ++i) {
+            if (rng() % 4 == 0) {
+                entries << " r" << i << ":1";
+                ++count;
+            }
+        }
+        if (count == 0) {
+            entries << " r" << j % rows << ":1";
+            count = 1;
+        }
+        job << "column " << 1.0 + 0.7 * count + (rng() % 100) / 50.0 << entries.str() << "\n";
+    }
+    job << "end\n";
+    return job.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " serve|submit|bench <socket> [arg] [metrics file]" << std::endl;
+        return 1;
+    }
+    const std::string mode = argv[1];
+    const std::string socketPath = argv[2];
+
+    try {
+        if (mode == "serve") {
+            DaemonParams params;
+            params.numSolvers = argc > 3 ? std::atoi(argv[3]) : 4;
+            if (argc > 4) {
+                params.metricsPath = argv[4];
+            }
+            SolveDaemon daemon(socketPath, params);
+            std::cout << "Listening on " << socketPath << " with " << params.numSolvers
+                      << " solvers" << std::endl;
+            daemon.run();
+
+            const DaemonStats stats = daemon.getStats();
+            std::cout << "Completed " << stats.completed << " jobs (" << stats.failed
+                      << " failed), " << stats.throughput << " jobs/s" << std::endl;
+            std::cout << "Latency mean/p50/p95/max: " << stats.meanLatency << " / "
+                      << stats.p50Latency << " / " << stats.p95Latency << " / "
+                      << stats.maxLatency << " s" << std::endl;
+        } else if (mode == "submit") {
+            if (argc < 4) {
+                throw std::runtime_error("submit needs a job file");
+            }
+            std::ifstream file(argv[3]);
+            if (!file) {
+                throw std::runtime_error(std::string("Cannot open ") + argv[3]);
+            }
+            std::stringstream text;
+            text << file.rdbuf();
+
+            int jobs = 0;
+            std::string line;
+            std::istringstream scan(text.str());
+            while (std::getline(scan, line)) {
+                jobs += line.rfind("job ", 0) == 0;
+            }
+
+            Client client(socketPath);
+            client.send(text.str());
+            while (jobs > 0) {
+                line = client.readLine();
+                std::cout << line << std::endl;
+                jobs -= isFinal(line);
+            }
+        } else if (mode == "bench") {
+            const int jobs = argc > 3 ? std::atoi(argv[3]) : 100;
+            std::mt19937 rng(7);
+            Client client(socketPath);
+            for (int j = 0; j < jobs; ++j) {
+                client.send(j % 2 == 0 ? knapsackJob(j, rng) : coveringJob(j, rng));
+            }
+            int remaining = jobs;
+            int errors = 0;
+            while (remaining > 0) {
+                const std::string line = client.readLine();
+                if (isFinal(line)) {
+                    --remaining;
+                    if (line.rfind("done ", 0) != 0) {
+                        ++errors;
+                        std::cout << line << std::endl;
+                    }
+                }
+            }
+            client.send("stats\n");
+            std::cout << jobs << " jobs, " << errors << " errors" << std::endl;
+            std::cout << client.readLine() << std::endl;
+        } else {
+            throw std::runtime_error("Unknown mode '" + mode + "'");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+// Offline pricing benchmark: record the pricing calls of a VRPTW column generation run
+// into a binary log, then replay them against any oracle without the master.
+//   08_pricing_replay record <log> [customers] [seed]
+//   08_pricing_replay replay <log> labeling|grasp|grasp+labeling [customers] [seed] [repetitions]
+// The instance is rebuilt from customers and seed, so replay them with the same values.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/column_generation.hpp"
+#include "../include/grasp_pricer.hpp"
+#include "../include/labeling_pricer.hpp"
+#include "../include/pricing_graph.hpp"
+#include "../include/pricing_recorder.hpp"
+
+namespace {
+
+constexpr double kHorizon = 240.0;
+constexpr double kCapacity = 100.0;
+constexpr double kService = 10.0;
+
+// Euclidean VRPTW around a central depot; source 0, customers 1..n, sink n+1
+PricingGraph buildGraph(int customers, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> demand(5, 20);
+    std::vector<double> x = {50.0};
+    std::vector<double> y = {50.0};
+
+    PricingGraph graph(customers + 2, 0, customers + 1);
+    graph.setCapacity(kCapacity);
+    for (int i = 1; i <= customers; ++i) {
+        x.push_back(coordinate(rng));
+        y.push_back(coordinate(rng));
+        const double reach = std::hypot(x.back() - 50.0, y.back() - 50.0);
+        PricingGraph::Node& node = graph.node(i);
+        node.row = i - 1;
+        node.demand = demand(rng);
+        node.earliest = reach + unit(rng) * (0.6 * kHorizon - reach);
+        node.latest = node.earliest + 30.0 + 30.0 * unit(rng);
+        node.service = kService;
+    }
+    for (int end : {0, customers + 1}) {
+        graph.node(end).row = -1;
+        graph.node(end).latest = kHorizon;
+    }
+    for (int i = 0; i <= customers; ++i) {
+        for (int j = 1; j <= customers + 1; ++j) {
+            const int site = j == customers + 1 ? 0 : j;
+            if (site != i) {
+                const double distance = std::hypot(x[i] - x[site], y[i] - y[site]);
+                graph.addArc(i, j, distance, distance);
+            }
+        }
+    }
+    graph.finalize();
+    return graph;
+}
+
+void record(const std::string& path, int customers, unsigned seed) {
+    const PricingGraph graph = buildGraph(customers, seed);
+    ScipSolver master("vrptw");
+    master.setColumnGenerationMode();
+    std::vector<ScipVariable> artificials;
+    std::vector<ScipConstraint> rows;
+    artificials.reserve(customers);
+    rows.reserve(customers);
+    std::vector<ScipConstraint*> rowPointers;
+    for (int i = 0; i < customers; ++i) {
+        artificials.push_back(master.createVariable("art_" + std::to_string(i), 0.0,
+                                                    SCIPinfinity(master.get()), 10000.0));
+        rows.push_back(master.createConstraint("visit_" + std::to_string(i),
+                                               {&artificials.back()}, {1.0},
+                                               1.0, SCIPinfinity(master.get())));
+        rowPointers.push_back(&rows.back());
+    }
+
+    LabelingPricer pricer(graph);
+    PricingRecorder recorder(path);
+    RecordingOracle recording(pricer, recorder);
+    ColumnGeneration cg(master, rowPointers);
+    cg.addOracle(&recording);
+    const ColumnGenerationStats stats = cg.run();
+    recorder.flush();
+
+    const PricingRecorderStats log = recorder.getStats();
+    std::cout << "LP " << std::fixed << std::setprecision(2) << stats.masterObjective
+              << " after " << stats.iterations << " iterations, pricing "
+              << std::setprecision(3) << stats.pricingTime << " s" << std::endl;
+    std::cout << "Recorded " << log.calls << " calls, " << log.columns << " columns, "
+              << log.bytes << " bytes (" << log.sparseDuals << " calls with sparse duals) to "
+              << path << std::endl;
+}
+
+void replay(const std::string& path, const std::string& oracleName, int customers,
+            unsigned seed, int repetitions) {
+    const PricingGraph graph = buildGraph(customers, seed);
+    LabelingPricer labeling(graph);
+    GraspPricer grasp(graph);
+    PricingOracle* oracle = &labeling;
+    if (oracleName == "grasp" || oracleName == "grasp+labeling") {
+        oracle = &grasp;
+        if (oracleName == "grasp+labeling") {
+            grasp.setFallback(&labeling);
+        }
+    } else if (oracleName != "labeling") {
+        throw std::runtime_error("Unknown oracle '" + oracleName + "'");
+    }
+
+    PricingReplay log(path);
+    std::cout << "Replaying " << log.getCalls().size() << " calls ("
+              << log.getStates().size() << " branching states) with " << oracleName << std::endl;
+    log.setBranchingHandler([](const PricingBranchingState& state) {
+        std::cout << "  node " << state.node << ", " << state.bounds.size()
+                  << " branching bounds" << std::endl;
+    });
+    // Every repetition draws the GRASP restarts of the recorded call
+    log.setResetHandler([&grasp](const RecordedPricingCall& call) {
+        grasp.setNextSeedCall(call.sequence + 1);
+    });
+    ReplayParams params;
+    params.repetitions = repetitions;
+    const std::vector<ReplayCallResult> results = log.run(*oracle, params);
+
+    std::cout << std::setw(6) << "call" << std::setw(9) << "cols" << std::setw(9) << "now"
+              << std::setw(12) << "best rc" << std::setw(12) << "now"
+              << std::setw(11) << "ms" << std::setw(11) << "now" << std::setw(8) << "ratio" << std::endl;
+    for (const ReplayCallResult& result : results) {
+        std::cout << std::setw(6) << result.sequence << std::setw(9) << result.recordedColumns
+                  << std::setw(9) << result.columns << std::fixed << std::setprecision(3)
+                  << std::setw(12) << result.recordedBestReducedCost
+                  << std::setw(12) << result.bestReducedCost
+                  << std::setw(11) << result.recordedSeconds * 1000.0
+                  << std::setw(11) << result.seconds * 1000.0
+                  << std::setw(8) << std::setprecision(2)
+                  << result.seconds / std::max(result.recordedSeconds, 1e-9) << std::endl;
+    }
+
+    const ReplaySummary summary = PricingReplay::summarize(results);
+    std::cout << "Total " << std::setprecision(3) << summary.recordedSeconds << " s recorded, "
+              << summary.seconds << " s now (x" << std::setprecision(2)
+              << summary.seconds / std::max(summary.recordedSeconds, 1e-9) << "); "
+              << summary.boundChanges << " bounds and " << summary.reducedCostChanges
+              << " best reduced costs differ" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " record <log> [customers] [seed]" << std::endl;
+        std::cerr << "       " << argv[0]
+                  << " replay <log> labeling|grasp|grasp+labeling [customers] [seed] [repetitions]"
+                  << std::endl;
+        return 1;
+    }
+    const std::string mode = argv[1];
+    const std::string path = argv[2];
+
+    try {
+        if (mode == "record") {
+            const int customers = argc > 3 ? std::atoi(argv[3]) : 25;
+            const unsigned seed = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : 1;
+            record(path, customers, seed);
+        } else if (mode == "replay") {
+            const std::string oracle = argc > 3 ? argv[3] : "labeling";
+            const int customers = argc > 4 ? std::atoi(argv[4]) : 25;
+            const unsigned seed = argc > 5 ? static_cast<unsigned>(std::atoi(argv[5])) : 1;
+            const int repetitions = argc > 6 ? std::atoi(argv[6]) : 1;
+            replay(path, oracle, customers, seed, repetitions);
+        } else {
+            throw std::runtime_error("Unknown mode '" + mode + "'");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
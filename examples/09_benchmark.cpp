@@ -0,0 +1,172 @@
+// Benchmark runner for performance regressions: runs a suite of VRPTW column generation
+// instances several times, prints shifted geometric means of time and iterations per
+// family with confidence intervals, and compares them with a stored baseline.
+// Usage: 09_benchmark [repetitions] [results file ("" = none)] [baseline file]
+// Exits with status 2 when a family regressed significantly against the baseline.
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/benchmark_suite.hpp"
+#include "../include/column_generation.hpp"
+#include "../include/grasp_pricer.hpp"
+#include "../include/labeling_pricer.hpp"
+#include "../include/pricing_graph.hpp"
+
+namespace {
+
+constexpr double kHorizon = 240.0;
+constexpr double kCapacity = 100.0;
+constexpr double kService = 10.0;
+
+// Euclidean VRPTW around a central depot; source 0, customers 1..n, sink n+1
+PricingGraph buildGraph(int customers, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> demand(5, 20);
+    std::vector<double> x = {50.0};
+    std::vector<double> y = {50.0};
+
+    PricingGraph graph(customers + 2, 0, customers + 1);
+    graph.setCapacity(kCapacity);
+    for (int i = 1; i <= customers; ++i) {
+        x.push_back(coordinate(rng));
+        y.push_back(coordinate(rng));
+        const double reach = std::hypot(x.back() - 50.0, y.back() - 50.0);
+        PricingGraph::Node& node = graph.node(i);
+        node.row = i - 1;
+        node.demand = demand(rng);
+        node.earliest = reach + unit(rng) * (0.6 * kHorizon - reach);
+        node.latest = node.earliest + 30.0 + 30.0 * unit(rng);
+        node.service = kService;
+    }
+    for (int end : {0, customers + 1}) {
+        graph.node(end).row = -1;
+        graph.node(end).latest = kHorizon;
+    }
+    for (int i = 0; i <= customers; ++i) {
+        for (int j = 1; j <= customers + 1; ++j) {
+            const int site = j == customers + 1 ? 0 : j;
+            if (site != i) {
+                const double distance = std::hypot(x[i] - x[site], y[i] - y[site]);
+                graph.addArc(i, j, distance, distance);
+            }
+        }
+    }
+    graph.finalize();
+    return graph;
+}
+
+// Column generation time (without model setup) and iterations of one instance
+BenchmarkSample solve(int customers, unsigned seed, bool grasp) {
+    const PricingGraph graph = buildGraph(customers, seed);
+    ScipSolver master("vrptw");
+    master.setColumnGenerationMode();
+    std::vector<ScipVariable> artificials;
+    std::vector<ScipConstraint> rows;
+    artificials.reserve(customers);
+    rows.reserve(customers);
+    std::vector<ScipConstraint*> rowPointers;
+    for (int i = 0; i < customers; ++i) {
+        artificials.push_back(master.createVariable("art_" + std::to_string(i), 0.0,
+                                                    SCIPinfinity(master.get()), 10000.0));
+        rows.push_back(master.createConstraint("visit_" + std::to_string(i),
+                                               {&artificials.back()}, {1.0},
+                                               1.0, SCIPinfinity(master.get())));
+        rowPointers.push_back(&rows.back());
+    }
+
+    LabelingPricer labeling(graph);
+    GraspPricer heuristic(graph);
+    heuristic.setFallback(&labeling);
+    ColumnGeneration cg(master, rowPointers);
+    cg.addOracle(grasp ? static_cast<PricingOracle*>(&heuristic) : &labeling);
+
+    const auto start = std::chrono::steady_clock::now();
+    const ColumnGenerationStats stats = cg.run();
+    BenchmarkSample sample;
+    sample.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sample.iterations = stats.iterations;
+    return sample;
+}
+
+const char* verdictName(BenchmarkVerdict verdict) {
+    switch (verdict) {
+        case BenchmarkVerdict::Improved: return "improved";
+        case BenchmarkVerdict::Regressed: return "REGRESSED";
+        default: return "unchanged";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkParams params;
+    params.repetitions = argc > 1 ? std::atoi(argv[1]) : 5;
+    const char* resultsPath = argc > 2 && argv[2][0] != '\0' ? argv[2] : nullptr;
+    const char* baselinePath = argc > 3 ? argv[3] : nullptr;
+
+    try {
+        BenchmarkSuite suite;
+        for (unsigned seed = 1; seed <= 4; ++seed) {
+            suite.add("vrptw15", "seed" + std::to_string(seed),
+                      [seed] { return solve(15, seed, false); });
+        }
+        for (unsigned seed = 1; seed <= 3; ++seed) {
+            suite.add("vrptw25", "seed" + std::to_string(seed),
+                      [seed] { return solve(25, seed, false); });
+            suite.add("vrptw25_grasp", "seed" + std::to_string(seed),
+                      [seed] { return solve(25, seed, true); });
+        }
+
+        std::cout << "=== Column Generation Benchmark ===" << std::endl;
+        std::cout << suite.getNumInstances() << " instances, " << params.warmup << " warmup and "
+                  << params.repetitions << " measured runs each" << std::endl;
+        const std::vector<BenchmarkRecord> records = suite.run(params);
+        if (resultsPath != nullptr) {
+            BenchmarkSuite::save(resultsPath, records);
+            std::cout << "Results written to " << resultsPath << std::endl;
+        }
+
+        const int level = static_cast<int>(params.confidence * 100.0 + 0.5);
+        std::cout << "Shifted geometric means (time shift " << params.timeShift
+                  << " s, iteration shift " << params.iterationShift << ") with "
+                  << level << "% intervals:" << std::endl;
+        for (const FamilySummary& family : BenchmarkSuite::summarize(records, params)) {
+            std::cout << "  " << std::setw(14) << std::left << family.family << std::right
+                      << std::fixed << std::setprecision(4)
+                      << " time " << family.seconds.value << " s [" << family.seconds.lower
+                      << ", " << family.seconds.upper << "]" << std::setprecision(1)
+                      << "  iterations " << family.iterations.value << " ["
+                      << family.iterations.lower << ", " << family.iterations.upper << "]" << std::endl;
+        }
+
+        if (baselinePath == nullptr) {
+            return 0;
+        }
+        const std::vector<BenchmarkRecord> baseline = BenchmarkSuite::load(baselinePath);
+        std::cout << "Ratio to baseline " << baselinePath << " (current / baseline):" << std::endl;
+        bool regressed = false;
+        for (const FamilyComparison& family : BenchmarkSuite::compare(records, baseline, params)) {
+            std::cout << "  " << std::setw(14) << std::left << family.family << std::right
+                      << std::setprecision(3)
+                      << " time " << family.seconds.ratio << " [" << family.seconds.lower << ", "
+                      << family.seconds.upper << "] " << std::setw(9) << verdictName(family.seconds.verdict)
+                      << "  iterations " << family.iterations.ratio << " [" << family.iterations.lower
+                      << ", " << family.iterations.upper << "] "
+                      << verdictName(family.iterations.verdict) << std::endl;
+            regressed = regressed || family.seconds.verdict == BenchmarkVerdict::Regressed
+                        || family.iterations.verdict == BenchmarkVerdict::Regressed;
+        }
+        return regressed ? 2 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef BENCHMARK_SUITE_HPP
+#define BENCHMARK_SUITE_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// What one run of an instance reports
+struct BenchmarkSample {
+    double seconds = -1.0;              // Negative: the runner's wall time of the call is used
+    double iterations = 0.0;            // E.g. column generation iterations
+};
+
+// One measured run, as stored in result and baseline files
+struct BenchmarkRecord {
+    std::string family;
+    std::string instance;
+    int repetition = 0;
+    double seconds = 0.0;
+    double iterations = 0.0;
+};
+
+struct BenchmarkParams {
+    int repetitions = 5;                // Measured runs per instance
+    int warmup = 1;                     // Discarded runs per instance before measuring
+    double timeShift = 0.01;            // Seconds added before taking logarithms
+    double iterationShift = 10.0;
+    double confidence = 0.95;           // Two-sided level of the intervals
+    double minChange = 0.05;            // Smallest relative change reported as significant
+    bool verbose = false;               // One line per run on std::cout
+};
+
+// Shifted geometric mean exp(mean(log(x + s))) - s with a confidence interval
+struct MeanEstimate {
+    double value = 0.0;
+    double lower = 0.0;
+    double upper = 0.0;
+};
+
+struct FamilySummary {
+    std::string family;
+    int instances = 0;
+    int repetitions = 0;
+    MeanEstimate seconds;
+    MeanEstimate iterations;
+};
+
+enum class BenchmarkVerdict {
+    Unchanged,                  // Interval contains 1 or the change is below minChange
+    Improved,
+    Regressed
+};
+
+// Ratio current / baseline of shifted geometric means with a confidence interval
+struct RatioEstimate {
+    double ratio = 1.0;
+    double lower = 1.0;
+    double upper = 1.0;
+    BenchmarkVerdict verdict = BenchmarkVerdict::Unchanged;
+};
+
+struct FamilyComparison {
+    std::string family;
+    int instances = 0;                  // Present in both runs
+    RatioEstimate seconds;
+    RatioEstimate iterations;
+};
+
+// Runs an instance suite several times and compares it with a stored baseline.
+// Repetitions are interleaved (every instance once, then again) so slow drifts of the
+// machine spread over all instances. Per family and repetition the shifted geometric
+// mean over the instances is taken; the repetitions give its confidence interval
+// (Student t on the log scale), and a Welch interval on the difference of the log means,
+// mapped back with the baseline mean held fixed, gives the interval of the ratio of the
+// shifted geometric means to the baseline's. A family regressed when the whole
+// interval lies above 1 and the ratio exceeds 1 + minChange.
+class BenchmarkSuite {
+private:
+    struct Entry {
+        std::string family;
+        std::string instance;
+        std::function<BenchmarkSample()> run;
+    };
+
+    std::vector<Entry> entries_;
+
+public:
+    void add(const std::string& family, const std::string& instance,
+             std::function<BenchmarkSample()> run);
+
+    std::vector<BenchmarkRecord> run(const BenchmarkParams& params = BenchmarkParams()) const;
+
+    // Whitespace-separated text, one record per line: family instance repetition seconds iterations
+    static void save(const std::string& path, const std::vector<BenchmarkRecord>& records);
+    static std::vector<BenchmarkRecord> load(const std::string& path);
+
+    static std::vector<FamilySummary> summarize(const std::vector<BenchmarkRecord>& records,
+                                                const BenchmarkParams& params = BenchmarkParams());
+
+    // Families and instances missing on either side are left out
+    static std::vector<FamilyComparison> compare(const std::vector<BenchmarkRecord>& current,
+                                                 const std::vector<BenchmarkRecord>& baseline,
+                                                 const BenchmarkParams& params = BenchmarkParams());
+
+    size_t getNumInstances() const { return entries_.size(); }
+};
+
+#endif // BENCHMARK_SUITE_HPP
@@ -0,0 +1,100 @@
+#ifndef BENDERS_DECOMPOSITION_HPP
+#define BENDERS_DECOMPOSITION_HPP
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include "scip_solver.hpp"
+
+// Technology entry: master variable x_k appears in subproblem row `row` with `coefficient`,
+// i.e. the row reads  lhs <= W y + coefficient * x_k <= rhs
+struct BendersLink {
+    int row;                        // Position in the subproblem's row list
+    ScipVariable* masterVariable;
+    double coefficient;
+};
+
+struct BendersParams {
+    int maxIterations = 200;
+    double tolerance = 1e-6;        // Relative gap between master bound and best solution
+    double etaLowerBound = -1e9;    // Initial lower bound of each recourse estimate
+    int numThreads = 0;             // Subproblems solved concurrently (0 = hardware threads)
+    bool verbose = false;
+};
+
+struct BendersStats {
+    int iterations = 0;
+    int optimalityCuts = 0;
+    int feasibilityCuts = 0;
+    double lowerBound = 0.0;        // Master objective
+    double upperBound = 0.0;        // Best first-stage plus recourse value found
+    double masterTime = 0.0;
+    double subproblemTime = 0.0;    // Wall-clock time of the (parallel) subproblem rounds
+    bool optimal = false;
+};
+
+// Benders decomposition on top of ScipSolver. The master holds the first-stage model;
+// every subproblem is an LP over second-stage columns whose rows depend on the master
+// through BendersLink entries. solve() runs the L-shaped loop with optimality cuts from
+// subproblem duals and feasibility cuts from an elastic phase-1 LP; solveWithScipBenders()
+// hands the same data to SCIP's built-in Benders framework instead.
+class BendersDecomposition {
+private:
+    struct Subproblem {
+        ScipSolver* solver;
+        std::vector<ScipConstraint*> rows;
+        std::vector<ScipVariable*> columns;
+        std::vector<BendersLink> links;
+        double weight;
+        std::vector<double> lhs;                 // Sides with x = 0
+        std::vector<double> rhs;
+        std::vector<double> objectives;          // Original column objectives
+        std::deque<ScipVariable> slacks;         // Elastic columns for the phase-1 LP
+        std::deque<ScipVariable> masterCopies;   // Only in SCIP framework mode
+        ScipVariable* eta = nullptr;
+    };
+
+    // Outcome of one subproblem at a master point
+    struct Evaluation {
+        bool feasible = true;
+        double value = 0.0;                      // Recourse value, or phase-1 infeasibility
+        std::vector<double> cutCoefficients;     // Per first-stage variable: sum_i dual_i * T_ik
+    };
+
+    ScipSolver& master_;                         // Non-owning reference
+    std::vector<ScipVariable*> firstStage_;
+    BendersParams params_;
+    std::vector<std::unique_ptr<Subproblem>> subproblems_;
+    std::deque<ScipVariable> etas_;
+    std::deque<ScipConstraint> cuts_;
+    bool prepared_ = false;
+    bool usedScipFramework_ = false;
+
+    int firstStageIndex(const ScipVariable* variable) const;
+    void prepare();
+    Evaluation evaluate(Subproblem& sub, const std::vector<double>& point);
+    void shiftSides(Subproblem& sub, const std::vector<double>& point);
+
+public:
+    BendersDecomposition(ScipSolver& master, const std::vector<ScipVariable*>& firstStage,
+                         const BendersParams& params = BendersParams());
+
+    // Register a subproblem (its solver must outlive the decomposition). Returns its index.
+    int addSubproblem(ScipSolver& solver,
+                      const std::vector<ScipConstraint*>& rows,
+                      const std::vector<ScipVariable*>& columns,
+                      const std::vector<BendersLink>& links,
+                      double weight = 1.0);
+
+    // In-house L-shaped loop
+    BendersStats solve();
+
+    // SCIP's default Benders plugin: first-stage variables are copied into every
+    // subproblem by name. Exclusive with solve() on the same instance.
+    void solveWithScipBenders();
+
+    // Recourse estimate of a subproblem in the last master solution
+    double getRecourseEstimate(int subproblem) const;
+};
+
+#endif // BENDERS_DECOMPOSITION_HPP
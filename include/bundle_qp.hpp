@@ -0,0 +1,42 @@
+#ifndef BUNDLE_QP_HPP
+#define BUNDLE_QP_HPP
+
+#include <vector>
+
+// Quadratic kernel of the proximal bundle master:
+//
+//   max_{pi in box}  min_k (alpha_k + g_k . pi)  -  (u/2) ||pi - center||^2
+//
+// solved through its dual over the unit simplex (one weight per cut) with accelerated
+// projected gradient. The box is per-coordinate [lower_i, upper_i] (may be infinite),
+// which keeps the inner maximization separable and closed-form.
+class BundleQp {
+private:
+    std::vector<double> weights_;     // Simplex multipliers of the last solve
+    std::vector<double> pi_;          // Maximizer of the last solve
+    double modelValue_ = 0.0;         // min_k (alpha_k + g_k . pi) at pi_
+    int iterations_ = 0;
+
+public:
+    // cuts[k] is g_k (one entry per row), alphas[k] its constant term.
+    // warmWeights (optional) restarts from the multipliers of a previous solve.
+    void solve(const std::vector<std::vector<double>>& cuts,
+               const std::vector<double>& alphas,
+               const std::vector<double>& center,
+               const std::vector<double>& lower,
+               const std::vector<double>& upper,
+               double u,
+               const std::vector<double>& warmWeights = {},
+               double tolerance = 1e-9,
+               int maxIterations = 5000);
+
+    const std::vector<double>& getWeights() const { return weights_; }
+    const std::vector<double>& getPi() const { return pi_; }
+    double getModelValue() const { return modelValue_; }
+    int getIterations() const { return iterations_; }
+
+    // Euclidean projection onto the unit simplex (in place)
+    static void projectSimplex(std::vector<double>& v);
+};
+
+#endif // BUNDLE_QP_HPP
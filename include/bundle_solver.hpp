@@ -0,0 +1,60 @@
+#ifndef BUNDLE_SOLVER_HPP
+#define BUNDLE_SOLVER_HPP
+
+#include <vector>
+#include "lagrangian_relaxation.hpp"
+#include "bundle_qp.hpp"
+
+// Tuning knobs of the proximal bundle method
+struct BundleParams {
+    int maxIterations = 500;
+    int maxBundleSize = 50;          // Cuts kept; older/inactive ones are aggregated away
+    int maxInactiveAge = 10;         // Iterations a zero-weight cut survives
+    double proximalWeight = 1.0;     // u: larger means shorter, more conservative steps
+    double minProximalWeight = 1e-6;
+    double maxProximalWeight = 1e6;
+    double seriousStepFraction = 0.1;  // m_L: fraction of predicted increase to accept a step
+    double tolerance = 1e-6;          // Relative predicted increase to stop at
+    double subgradientTolerance = 1e-3;  // Max aggregate subgradient entry (row violation) to stop at
+};
+
+// Proximal bundle master for the Lagrangian dual of a ScipSolver model: a bounded
+// bundle of cutting planes, a small stabilized QP per iteration and serious/null steps.
+class BundleSolver {
+private:
+    struct Cut {
+        std::vector<double> subgradient;
+        double alpha;                 // Constant term: value = alpha + subgradient . pi
+        std::vector<double> primal;   // Lagrangian minimizer (or aggregate) behind the cut
+        int inactiveAge;
+    };
+
+    LagrangianRelaxation relaxation_;
+    BundleParams params_;
+    BundleQp qp_;
+    std::vector<Cut> bundle_;
+
+    void addCut(const std::vector<double>& pi, double value,
+                const std::vector<double>& g, const std::vector<double>& x);
+    void compressBundle(const std::vector<double>& weights, std::vector<double>& keptWeights);
+
+public:
+    BundleSolver(ScipSolver& solver,
+                 const std::vector<ScipConstraint*>& rows,
+                 const std::vector<ScipVariable*>& columns,
+                 const BundleParams& params = BundleParams());
+
+    void setParams(const BundleParams& params) { params_ = params; }
+    const BundleParams& getParams() const { return params_; }
+
+    // Columns priced in after construction; the bundle is rebuilt on the next solve
+    void addColumn(ScipVariable* column) { relaxation_.addColumn(column); }
+    void reload() { relaxation_.reload(); }
+
+    // Run the bundle method; initialDuals (model sense) is the first stability center
+    LagrangianSolution solve(const std::vector<double>& initialDuals = {});
+
+    int getBundleSize() const { return static_cast<int>(bundle_.size()); }
+};
+
+#endif // BUNDLE_SOLVER_HPP
@@ -0,0 +1,18 @@
+#ifndef COLUMN_HPP
+#define COLUMN_HPP
+
+#include <limits>
+#include <string>
+#include <vector>
+
+// Sparse master column as exchanged between pricing and the master
+struct Column {
+    double cost = 0.0;
+    std::vector<int> rows;           // Positions in the master's row list
+    std::vector<double> values;      // Coefficient per entry of rows
+    double reducedCost = 0.0;        // Filled in by the oracle that priced it
+    double upperBound = std::numeric_limits<double>::infinity();
+    std::string name;                // Optional; the master picks one if empty
+};
+
+#endif // COLUMN_HPP
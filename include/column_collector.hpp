@@ -0,0 +1,59 @@
+#ifndef COLUMN_COLLECTOR_HPP
+#define COLUMN_COLLECTOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "column.hpp"
+
+// Thread-safe collection of the k most negative reduced-cost columns offered by many
+// threads. Columns with equal rows and coefficients are kept once, at the lowest reduced
+// cost. Once full, offers that cannot enter are rejected by one atomic load, so workers
+// can test accepts() before building a column at all.
+class TopKColumnCollector {
+private:
+    size_t capacity_;
+    double tolerance_;                          // Only reduced costs below -tolerance enter
+
+    mutable std::mutex mutex_;
+    std::vector<Column> slots_;
+    std::vector<size_t> freeSlots_;
+    std::set<std::pair<double, size_t>> order_;             // (reduced cost, slot)
+    std::unordered_map<std::string, size_t> keys_;          // Coefficients -> slot
+    std::atomic<double> threshold_;             // Reduced cost an offer must beat
+    std::atomic<uint64_t> offered_;
+    std::atomic<uint64_t> accepted_;
+
+    static std::string key(const Column& column);
+    void updateThreshold();                     // Caller holds mutex_
+
+public:
+    explicit TopKColumnCollector(size_t capacity, double tolerance = 1e-6);
+
+    TopKColumnCollector(const TopKColumnCollector&) = delete;
+    TopKColumnCollector& operator=(const TopKColumnCollector&) = delete;
+
+    // Cheap pre-check of a reduced cost (may race with concurrent offers)
+    bool accepts(double reducedCost) const {
+        return reducedCost < threshold_.load(std::memory_order_relaxed);
+    }
+
+    // True if the column entered (it may be evicted again by better offers)
+    bool offer(Column&& column);
+
+    // Move the collected columns out, most negative reduced cost first, and reset
+    size_t drain(std::vector<Column>& columns);
+
+    size_t size() const;
+    size_t capacity() const { return capacity_; }
+    uint64_t getNumOffered() const { return offered_.load(std::memory_order_relaxed); }
+    uint64_t getNumAccepted() const { return accepted_.load(std::memory_order_relaxed); }
+};
+
+#endif // COLUMN_COLLECTOR_HPP
@@ -0,0 +1,122 @@
+#ifndef COLUMN_GENERATION_HPP
+#define COLUMN_GENERATION_HPP
+
+#include <deque>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "scip_solver.hpp"
+#include "column.hpp"
+#include "pricing_oracle.hpp"
+
+struct ColumnGenerationParams {
+    int maxIterations = 1000;
+    int maxColumnsPerIteration = 100;   // Most negative reduced costs first
+    double reducedCostTolerance = 1e-6;
+    bool verbose = false;               // One line per iteration on std::cout
+    // Seconds for the whole run; also bounds every master solve by the time left
+    double timeLimit = std::numeric_limits<double>::infinity();
+    // Value of a known integer solution; enables reduced-cost fixing when finite
+    double incumbentValue = std::numeric_limits<double>::infinity();
+};
+
+struct ColumnGenerationStats {
+    int iterations = 0;
+    int columnsAdded = 0;
+    int columnsDrained = 0;             // Taken from the column queue
+    int columnsFixed = 0;               // Upper bounds tightened by reduced-cost fixing
+    double masterObjective = 0.0;       // Last restricted master LP value
+    double lagrangianBound = 0.0;       // Best valid lower bound (-infinity if unknown)
+    double masterTime = 0.0;            // Seconds spent in master solves
+    double pricingTime = 0.0;           // Seconds spent in oracles
+    bool optimal = false;               // No negative reduced cost column left
+};
+
+class ColumnQueue;
+class RunLog;
+class SolverMetrics;
+
+// Upper bound of a master column before reduced-cost fixing changed it
+struct ColumnBoundChange {
+    int column;
+    double oldUpperBound;
+};
+
+// Column generation loop over a ScipSolver LP master (minimization).
+// The caller owns the master rows; the driver owns the columns it adds.
+class ColumnGeneration {
+private:
+    ScipSolver& master_;                      // Non-owning reference
+    std::vector<ScipConstraint*> rows_;
+    std::vector<PricingOracle*> oracles_;
+    ColumnQueue* queue_;                      // Optional; columns pushed by pricing threads
+    std::vector<Column> queueCarryOver_;      // Drained but not added yet, best first
+    RunLog* log_;                             // Optional; one record per iteration
+    SolverMetrics* metrics_;                  // Optional; updated every iteration
+    std::vector<int> metricIds_;              // Slots of the loop metrics
+    std::vector<int> oracleMetricIds_;        // Pricing seconds and calls per oracle
+    std::string metricLabels_;                // Added to every metric, e.g. solver="2"
+
+    void registerMetrics();
+    void registerOracleMetrics(const PricingOracle* oracle);
+    std::deque<ScipVariable> columns_;        // Deque keeps column addresses stable
+    std::vector<Column> columnData_;          // Sparse copy of every added column
+    std::unordered_map<std::string, int> columnIndex_;  // Cost and coefficients -> column
+    std::vector<double> duals_;               // Duals of the last master solve
+    double lastBound_;                        // Lagrangian bound at duals_ (-inf if unknown)
+
+public:
+    ColumnGeneration(ScipSolver& master, const std::vector<ScipConstraint*>& rows);
+
+    // No copying (owns SCIP variables)
+    ColumnGeneration(const ColumnGeneration&) = delete;
+    ColumnGeneration& operator=(const ColumnGeneration&) = delete;
+
+    void addOracle(PricingOracle* oracle);
+
+    // Columns pushed to the queue by concurrent pricing threads are drained before every
+    // re-solve, re-priced against the current duals and compete with the oracles' columns.
+    // Drained columns that miss the cut are kept (up to half the queue capacity) and
+    // compete again in later rounds; the queue is drained only as far as there is room.
+    void setColumnQueue(ColumnQueue* queue) { queue_ = queue; }
+
+    // Every iteration and the end of every run are written to the log (nullptr: none)
+    void setRunLog(RunLog* log) { log_ = log; }
+
+    // Iterations, bounds, gap, master columns and per-oracle pricing time are kept in
+    // the metrics' atomic slots, registered here once (nullptr: none). Drivers sharing
+    // one SolverMetrics need distinct labels (e.g. solver="2"), or their gauges overwrite
+    // each other; equal labels add up their counters.
+    void setMetrics(SolverMetrics* metrics, const std::string& labels = "");
+
+    // Create the variable in the master and add its coefficients to the rows. A column
+    // with the same cost, rows and coefficients as a master column returns that column
+    // unchanged, so pricing it again cannot undo reduced-cost fixing.
+    ScipVariable& addColumn(const Column& column);
+
+    // Master column with exactly this cost, rows and coefficients, or -1
+    int findColumn(const Column& column) const;
+
+    // Solve the master and price until no improving column is found
+    ColumnGenerationStats run(const ColumnGenerationParams& params = ColumnGenerationParams());
+
+    // Reduced-cost fixing with the duals and Lagrangian bound of the last pricing round:
+    // a solution using column j at value v costs at least bound + rc_j * v, so its upper
+    // bound drops to (incumbent - bound) / rc_j, rounded down for integral columns.
+    // The returned changes undo the fixing, e.g. when leaving a branch-and-price node.
+    std::vector<ColumnBoundChange> fixColumnsByReducedCost(double incumbent, bool integral = true);
+    void restoreColumnBounds(const std::vector<ColumnBoundChange>& changes);
+
+    // Accessors
+    ScipSolver& getMaster() { return master_; }
+    const std::vector<ScipConstraint*>& getRows() const { return rows_; }
+    const std::vector<PricingOracle*>& getOracles() const { return oracles_; }
+    int getNumColumns() const { return static_cast<int>(columns_.size()); }
+    ScipVariable& getColumn(int index) { return columns_.at(index); }
+    const Column& getColumnData(int index) const { return columnData_.at(index); }
+    const std::vector<double>& getDuals() const { return duals_; }
+    double getLastLagrangianBound() const { return lastBound_; }
+};
+
+#endif // COLUMN_GENERATION_HPP
@@ -0,0 +1,141 @@
+#ifndef COLUMN_LNS_HPP
+#define COLUMN_LNS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "column.hpp"
+#include "column_generation.hpp"
+#include "pricing_oracle.hpp"
+#include "task_scheduler.hpp"
+
+class ColumnQueue;
+struct ScipSolution;
+
+struct LnsParams {
+    int concurrentMoves = 2;            // Move chains running at the same time
+    double destroyFraction = 0.3;       // Share of the incumbent's columns freed per move
+    int maxPricingIterations = 50;      // Restricted CG rounds in the sub-master
+    double moveTimeLimit = 10.0;        // Seconds for pricing plus sub-MIP of one move
+    double minImprovement = 1e-6;       // Absolute objective gain to accept a move
+    int maxMoves = 0;                   // Per chain; 0 = until stop()
+    unsigned seed = 1;
+};
+
+struct LnsStats {
+    uint64_t moves = 0;
+    uint64_t improvements = 0;
+    uint64_t failedMoves = 0;           // Exceptions in pricing or the sub-MIP
+    uint64_t columnsPriced = 0;         // New columns found by restricted pricing
+    double bestObjective = std::numeric_limits<double>::infinity();
+};
+
+// Integer master solution as columns with values
+struct LnsSolution {
+    double objective = std::numeric_limits<double>::infinity();
+    std::vector<Column> columns;
+    std::vector<double> values;
+};
+
+// Large neighbourhood search on an integer column-generation master, as low-priority
+// tasks on a TaskScheduler while the main column generation continues. Each of the
+// concurrentMoves chains runs one move at a time and submits its next move when done.
+// A move frees the incumbent columns closest to a random seed column (row distance,
+// e.g. routes of one region), fixes all others, and rebuilds a sub-master over the
+// freed rows only: restricted column generation prices new columns for them (fixed
+// rows get prohibitive duals), then a sub-MIP over the pool and the new columns is
+// solved with the incumbent as cutoff. Better solutions replace the incumbent.
+//
+// Moves never touch the main master: the constructor snapshots its rows and columns,
+// later columns and incumbents are offered through the thread-safe offer* calls (e.g.
+// from an IncumbentStream callback), and every chain owns its own pricing oracle made
+// by the factory. The column pool is a list of immutable segments, so a move takes a
+// snapshot by copying pointers only.
+class ColumnLns {
+private:
+    int numRows_;
+    std::vector<double> lhs_;
+    std::vector<double> rhs_;
+    std::function<std::unique_ptr<PricingOracle>()> oracleFactory_;
+    LnsParams params_;
+    std::function<double(int, int)> rowDistance_;
+    std::function<void(const LnsSolution&)> onImprovement_;
+    ColumnQueue* queue_;                        // Optional; receives newly priced columns
+
+    TaskScheduler& scheduler_;                  // Non-owning reference
+    TaskGroup group_;                           // Moves in flight
+
+    // One per concurrent move; a chain's next move is submitted when its last one ends
+    struct Chain {
+        std::unique_ptr<PricingOracle> oracle;
+        std::mt19937 rng;
+        int moves = 0;
+        bool waiting = true;                    // Not submitted (no incumbent yet)
+    };
+    std::vector<Chain> chains_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<const std::vector<Column>>> pool_;  // Immutable segments
+    std::unordered_set<std::string> poolKeys_;
+    LnsSolution best_;
+    double cutoff_;                             // Best objective known anywhere
+    LnsStats stats_;
+    bool running_;
+
+    std::atomic<bool> stop_;
+
+    // Append the columns not in the pool yet as one segment (nullptr: none);
+    // caller holds mutex_
+    std::shared_ptr<const std::vector<Column>> addToPool(const std::vector<Column>& columns);
+    void submitWaiting();                       // Caller holds mutex_
+    void runMove(size_t chain);
+    bool move(PricingOracle* oracle, std::mt19937& rng);     // True on improvement
+
+public:
+    // Snapshots the master's row sides and columns; call from the thread owning cg
+    explicit ColumnLns(ColumnGeneration& cg,
+                       std::function<std::unique_ptr<PricingOracle>()> oracleFactory = nullptr,
+                       TaskScheduler& scheduler = TaskScheduler::shared(),
+                       const LnsParams& params = LnsParams());
+    ~ColumnLns();
+
+    ColumnLns(const ColumnLns&) = delete;
+    ColumnLns& operator=(const ColumnLns&) = delete;
+
+    // Configuration, before start()
+    void setRowDistance(std::function<double(int, int)> distance) {
+        rowDistance_ = std::move(distance);
+    }
+    void setColumnQueue(ColumnQueue* queue) { queue_ = queue; }
+    void onImprovement(std::function<void(const LnsSolution&)> callback) {
+        onImprovement_ = std::move(callback);
+    }
+
+    // Thread-safe inputs
+    void offerColumns(const std::vector<Column>& columns);
+    void offerIncumbent(const std::vector<Column>& columns, const std::vector<double>& values);
+    void offerCutoff(double objective);
+
+    // Incumbent of the main master from an IncumbentStream over getColumnVariables(cg).
+    // Call on the thread owning cg. A solution whose objective the columns do not
+    // explain (e.g. artificials at nonzero) only tightens the cutoff.
+    void offerIncumbent(const ColumnGeneration& cg, const ScipSolution& solution);
+
+    // The master's column variables, position j holding column j
+    static std::vector<ScipVariable*> getColumnVariables(ColumnGeneration& cg);
+
+    void start();
+    void stop();
+
+    LnsSolution getBest() const;
+    LnsStats getStats() const;
+};
+
+#endif // COLUMN_LNS_HPP
@@ -0,0 +1,71 @@
+#ifndef COLUMN_QUEUE_HPP
+#define COLUMN_QUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "column.hpp"
+
+struct ColumnQueueStats {
+    uint64_t pushed = 0;
+    uint64_t drained = 0;
+    uint64_t fullEvents = 0;        // Push attempts that found the queue full
+};
+
+// Bounded lock-free multi-producer single-consumer queue of columns (Vyukov's bounded
+// queue: every slot carries a sequence number telling producers and the consumer whose
+// turn it is). Rows and values live in slabs preallocated per slot, so pushing never
+// allocates. Column names are not transported. Pricing threads push; the thread that
+// owns the master drains in batches.
+class ColumnQueue {
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence;
+        double cost;
+        double reducedCost;
+        double upperBound;
+        int32_t count;
+    };
+
+    const uint64_t capacity_;
+    const uint64_t mask_;
+    const int maxNonzeros_;
+    std::unique_ptr<Slot[]> slots_;
+    std::vector<int32_t> rowSlab_;          // maxNonzeros_ entries per slot
+    std::vector<double> valueSlab_;
+
+    alignas(64) std::atomic<uint64_t> enqueuePos_;
+    alignas(64) uint64_t dequeuePos_;       // Consumer only
+    std::atomic<bool> closed_;
+    std::atomic<uint64_t> pushed_;
+    std::atomic<uint64_t> fullEvents_;
+    std::atomic<uint64_t> drained_;
+
+public:
+    // capacity is rounded up to a power of two; longer columns than maxNonzeros are rejected
+    ColumnQueue(size_t capacity, int maxNonzeros);
+
+    ColumnQueue(const ColumnQueue&) = delete;
+    ColumnQueue& operator=(const ColumnQueue&) = delete;
+
+    // Producers. tryPush returns false when full; push waits for space (backpressure)
+    // and returns false only once the queue is closed.
+    bool tryPush(const Column& column);
+    bool push(const Column& column);
+
+    // Consumer: append up to maxColumns queued columns to out, returns how many
+    size_t drain(std::vector<Column>& out, size_t maxColumns);
+
+    // Wake blocked producers and refuse further columns
+    void close() { closed_.store(true, std::memory_order_release); }
+    bool isClosed() const { return closed_.load(std::memory_order_acquire); }
+
+    // Approximate when producers are active
+    size_t size() const;
+    size_t capacity() const { return static_cast<size_t>(capacity_); }
+    int getMaxNonzeros() const { return maxNonzeros_; }
+    ColumnQueueStats getStats() const;
+};
+
+#endif // COLUMN_QUEUE_HPP
@@ -0,0 +1,83 @@
+#ifndef COLUMN_STORE_HPP
+#define COLUMN_STORE_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "column.hpp"
+#include "pricing_oracle.hpp"
+
+// Compact column-major store for explicitly known columns that are too many to load
+// into SCIP. Row indices are 32-bit and the pricing scan reads single-precision
+// coefficients; once a coefficient is not exactly a float, the doubles are kept as well so
+// columns handed to the master are exact. Stores built with unitCoefficients (set
+// partitioning/covering) keep no coefficients at all.
+class ColumnStore {
+private:
+    int numRows_;
+    bool unitCoefficients_;
+    std::vector<double> costs_;
+    std::vector<int64_t> start_;      // start_[j]..start_[j+1] indexes rowIndex_/values_
+    std::vector<int32_t> rowIndex_;
+    std::vector<float> values_;       // Empty when unitCoefficients_
+    std::vector<double> exactValues_; // Empty while every value is exactly a float
+
+    double value(int64_t k) const {
+        return exactValues_.empty() ? static_cast<double>(values_[k]) : exactValues_[k];
+    }
+
+public:
+    explicit ColumnStore(int numRows, bool unitCoefficients = false);
+
+    void reserve(size_t columns, size_t nonzeros);
+
+    // Append a column; values may be omitted for unit-coefficient stores. Returns its index.
+    size_t addColumn(double cost, const std::vector<int>& rows,
+                     const std::vector<double>& values = {});
+
+    size_t size() const { return costs_.size(); }
+    int getNumRows() const { return numRows_; }
+    size_t getNumNonzeros() const { return rowIndex_.size(); }
+    size_t getMemoryBytes() const;
+    bool hasUnitCoefficients() const { return unitCoefficients_; }
+
+    double getCost(size_t column) const { return costs_[column]; }
+
+    // Row indices of a column as a [first, last) pointer range (no allocation)
+    std::pair<const int32_t*, const int32_t*> getRows(size_t column) const {
+        return {rowIndex_.data() + start_[column], rowIndex_.data() + start_[column + 1]};
+    }
+
+    // Materialize a stored column as a master column record
+    Column getColumn(size_t column) const;
+
+    // Reduced cost of one column from the exact coefficients
+    double reducedCost(const double* duals, size_t column) const;
+
+    // Reduced costs of columns [begin, end) into out[0 .. end-begin) from the float
+    // coefficients. Tight loops over contiguous arrays so the compiler can vectorize the gathers.
+    void reducedCosts(const double* duals, size_t begin, size_t end, double* out) const;
+};
+
+// Pricing step of sifting: scans the whole store for the most negative reduced costs
+class ColumnStorePricer : public PricingOracle {
+private:
+    const ColumnStore& store_;          // Non-owning reference
+    int maxColumns_;                    // Columns returned per call
+    double tolerance_;
+    double multiplicity_;
+    std::vector<double> buffer_;        // Reduced costs of one scan block
+
+public:
+    ColumnStorePricer(const ColumnStore& store, int maxColumns = 100, double tolerance = 1e-6);
+
+    std::string getName() const override { return "column_store"; }
+    double price(const std::vector<double>& duals, std::vector<Column>& columns) override;
+
+    // Bound on the total value of store columns in a solution (enables a Lagrangian bound)
+    void setMultiplicity(double multiplicity) { multiplicity_ = multiplicity; }
+    double getMultiplicity() const override { return multiplicity_; }
+};
+
+#endif // COLUMN_STORE_HPP
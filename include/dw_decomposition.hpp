@@ -0,0 +1,157 @@
+#ifndef DW_DECOMPOSITION_HPP
+#define DW_DECOMPOSITION_HPP
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "scip_solver.hpp"
+#include "column_generation.hpp"
+
+// Block-diagonal structure with linking rows, as indices into the compact model's
+// row and column lists
+struct DecompositionStructure {
+    std::vector<int> linkingRows;
+    std::vector<std::vector<int>> blockRows;
+    std::vector<std::vector<int>> blockColumns;
+
+    int getNumBlocks() const { return static_cast<int>(blockColumns.size()); }
+};
+
+// Groups of blocks that are identical up to renaming: same column bounds, types and
+// costs, same block rows and same linking coefficients, position by position in the
+// blocks' column and row lists. Any permutation of an orbit's blocks maps master
+// solutions to master solutions of equal cost.
+std::vector<std::vector<int>> findIdenticalBlocks(const std::vector<ScipConstraint*>& rows,
+                                                  const std::vector<ScipVariable*>& columns,
+                                                  const DecompositionStructure& structure);
+
+struct DecompositionParams {
+    double maxLinkingFraction = 0.2;   // At most this share of rows may become linking
+    int maxBlocks = 64;                // Smallest blocks are merged beyond this
+};
+
+// Detects block-diagonal structure in the row-net hypergraph of a compact model
+// (columns are vertices, rows are hyperedges). Rows are made linking from the densest
+// down; for every candidate cut the blocks are the connected components of the
+// remaining rows, and the cut balancing linking share against largest block wins.
+class DecompositionDetector {
+public:
+    static DecompositionStructure detect(const std::vector<ScipConstraint*>& rows,
+                                         const std::vector<ScipVariable*>& columns,
+                                         const DecompositionParams& params = DecompositionParams());
+};
+
+// Pricing subproblem of one block: a sub-MIP over copies of the block's columns
+class DantzigWolfeBlockPricer : public PricingOracle {
+private:
+    struct LinkEntry {
+        int masterRow;
+        double coefficient;
+    };
+
+    int block_;
+    int convexityRow_;                          // Master row of this block's convexity constraint
+    ScipSolver sub_;
+    std::vector<ScipVariable> vars_;            // Copies of the block columns, in block order
+    std::vector<ScipConstraint> cons_;
+    std::vector<double> costs_;                 // Original objective per block column
+    std::vector<std::vector<LinkEntry>> links_; // Linking-row coefficients per block column
+    std::map<std::string, std::vector<double>> solutions_;  // Block point behind each column
+    int generated_;
+    int multiplicity_;                          // Identical blocks this pricer stands for
+
+public:
+    DantzigWolfeBlockPricer(int block, int convexityRow,
+                            const std::vector<ScipConstraint*>& compactRows,
+                            const std::vector<ScipVariable*>& compactColumns,
+                            const DecompositionStructure& structure,
+                            const std::vector<int>& masterRowOfLinking,
+                            int multiplicity = 1);
+
+    std::string getName() const override { return "dw_block_" + std::to_string(block_); }
+    double price(const std::vector<double>& duals, std::vector<Column>& columns) override;
+    double getMultiplicity() const override { return multiplicity_; }
+
+    // Block point (in block column order) of a column this pricer generated, or nullptr
+    const std::vector<double>* findSolution(const std::string& columnName) const;
+
+    // Master column for a given block point (cost, linking coefficients, convexity entry)
+    Column makeColumn(const std::vector<double>& point) const;
+
+    int getBlock() const { return block_; }
+};
+
+struct DantzigWolfeParams {
+    DecompositionParams detection;
+    ColumnGenerationParams columnGeneration;
+    double artificialCost = 1e6;      // Cost of the slack columns that keep the master feasible
+    // One pricer and one convexity row (= orbit size) per orbit of identical blocks, so
+    // the master never holds the same column once per block copy
+    bool aggregateIdenticalBlocks = true;
+};
+
+// Branching candidate that is invariant under permuting identical blocks
+struct AggregatedBranchingCandidate {
+    int orbit = -1;                   // Index into getBlockOrbits()
+    int blockColumn = -1;             // Position in the blocks' column lists
+    double value = 0.0;               // Sum over the orbit's blocks of that column
+};
+
+// Automatic Dantzig-Wolfe reformulation of a compact ScipSolver model: detects the
+// structure, builds the master (linking rows + one convexity row per block) and one
+// sub-MIP per block, then runs column generation over it. Compact model must minimize
+// and its blocks must be bounded. Identical blocks are aggregated by default; the
+// compact solution then gives each unit of an integral orbit's columns to its own block,
+// and spreads a fractional orbit's convex combination evenly over its blocks.
+class DantzigWolfeSolver {
+private:
+    std::vector<ScipConstraint*> compactRows_;
+    std::vector<ScipVariable*> compactColumns_;
+    DantzigWolfeParams params_;
+    DecompositionStructure structure_;
+    std::vector<std::vector<int>> orbits_;      // Blocks per orbit; singletons when not aggregated
+
+    ScipSolver master_;
+    std::deque<ScipVariable> artificials_;
+    std::deque<ScipConstraint> masterRows_;
+    std::vector<std::unique_ptr<DantzigWolfeBlockPricer>> pricers_;
+    std::unique_ptr<ColumnGeneration> cg_;
+
+    void buildMaster();
+
+public:
+    DantzigWolfeSolver(ScipSolver& compact,
+                       const std::vector<ScipConstraint*>& rows,
+                       const std::vector<ScipVariable*>& columns,
+                       const DantzigWolfeParams& params = DantzigWolfeParams());
+
+    // Use a known structure instead of the detected one (call before solve)
+    void setStructure(const DecompositionStructure& structure);
+
+    ColumnGenerationStats solve();
+
+    // Compact column values of the master LP solution (sum of lambda times block points).
+    // Integral when every orbit's lambdas are integral; otherwise blocks of an orbit get
+    // equal shares, which can be fractional even where the orbit sums are integral.
+    std::vector<double> getCompactSolution();
+
+    // True when slack columns are still used, i.e. the master LP is infeasible
+    bool usesArtificials();
+
+    // Most fractional orbit sum of a block column in the master LP solution, or orbit -1
+    // when all are integral. Branching on orbit sums instead of single block copies
+    // never creates subtrees that are images of each other under block permutations.
+    // Integral orbit sums do not imply an integral compact solution: with fractional
+    // lambdas (e.g. three columns at 2/3 whose points sum to integers) getCompactSolution
+    // can still be fractional, and another branching rule has to finish the node.
+    AggregatedBranchingCandidate findBranchingCandidate(double tolerance = 1e-6);
+
+    const DecompositionStructure& getStructure() const { return structure_; }
+    const std::vector<std::vector<int>>& getBlockOrbits() const { return orbits_; }
+    ScipSolver& getMaster() { return master_; }
+    ColumnGeneration& getColumnGeneration() { return *cg_; }
+};
+
+#endif // DW_DECOMPOSITION_HPP
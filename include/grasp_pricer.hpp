@@ -0,0 +1,112 @@
+#ifndef GRASP_PRICER_HPP
+#define GRASP_PRICER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "column_collector.hpp"
+#include "pricing_graph.hpp"
+#include "pricing_oracle.hpp"
+#include "task_scheduler.hpp"
+
+class PricingReplicas;
+
+struct GraspParams {
+    int restarts = 256;                 // Independent constructions per call
+    double alpha = 0.3;                 // Candidate list: scores within alpha of the score range
+    int localSearchRounds = 20;         // Improvement passes per restart (0: construction only)
+    int maxColumns = 200;               // Best distinct columns returned per call
+    size_t grain = 8;                   // Restarts per scheduler task
+    unsigned seed = 1;
+    double tolerance = 1e-6;
+    double multiplicity = std::numeric_limits<double>::infinity();
+};
+
+struct GraspStats {
+    uint64_t calls = 0;
+    uint64_t restarts = 0;
+    uint64_t routesOffered = 0;         // Negative routes handed to the collector
+    uint64_t routesAccepted = 0;        // Entered the collector (before later evictions)
+    uint64_t improved = 0;              // Restarts whose route local search improved
+    uint64_t fallbackCalls = 0;         // Calls answered by the exact fallback
+};
+
+// Heuristic path pricing on a PricingGraph for early column generation iterations:
+// GRASP restarts build routes by randomized greedy construction (next customer drawn
+// from the arcs with the best reduced costs, route cut at its best prefix) and improve
+// them by remove / insert / replace local search. Restarts run as TaskScheduler tasks
+// with their own seeded generators, so results do not depend on the schedule, and feed
+// a TopKColumnCollector that keeps the most negative distinct routes. On its own it
+// returns -infinity as it proves no bound; with an exact fallback oracle, calls where
+// GRASP finds nothing are answered (and bounded) by the fallback. With PricingReplicas,
+// every call publishes the duals to the NUMA replicas and each restart reads the graph,
+// duals and arc reduced costs of the replica on its worker's node.
+class GraspPricer : public PricingOracle {
+private:
+    // Pricing data a restart reads: the shared graph or a NUMA replica
+    struct View {
+        const PricingGraph& graph;
+        const std::vector<double>& duals;
+        const std::vector<double>& reducedCost;     // Per arc
+        double pathDual;
+    };
+
+    const PricingGraph& graph_;         // Non-owning reference
+    PricingReplicas* replicas_;         // Optional; replicas of graph_, non-owning
+    TaskScheduler& scheduler_;
+    GraspParams params_;
+    std::string name_;
+    TopKColumnCollector collector_;
+    PricingOracle* fallback_;           // Optional exact oracle; non-owning
+    std::vector<std::vector<std::pair<int, int>>> arcTo_;   // Per tail: (head, arc) by head
+    std::vector<int> customers_;        // Nodes covering a master row
+
+    // Read-only during a call (unused with replicas)
+    std::vector<double> reducedCost_;
+
+    uint64_t calls_;
+    uint64_t nextSeedCall_;             // Seeds the restarts of the next call
+    uint64_t seedCall_;                 // Of the current call
+    uint64_t fallbackCalls_;
+    std::atomic<uint64_t> restarts_;
+    std::atomic<uint64_t> offered_;
+    std::atomic<uint64_t> improved_;
+
+    int findArc(const View& view, int tail, int head) const;
+    double evaluate(const View& view, const std::vector<int>& route) const;   // +infinity if infeasible
+    void construct(const View& view, std::mt19937& rng, std::vector<int>& route,
+                   std::vector<char>& inRoute) const;
+    double localSearch(const View& view, std::mt19937& rng, std::vector<int>& route,
+                       std::vector<char>& inRoute, double value) const;
+    void offer(const View& view, const std::vector<int>& route);
+    void runRestart(const View& view, uint64_t restart);
+
+public:
+    explicit GraspPricer(const PricingGraph& graph,
+                         TaskScheduler& scheduler = TaskScheduler::shared(),
+                         const GraspParams& params = GraspParams(),
+                         const std::string& name = "grasp");
+
+    // Exact oracle for calls without a negative GRASP route (nullptr: none)
+    void setFallback(PricingOracle* fallback) { fallback_ = fallback; }
+
+    // NUMA replicas of the graph (nullptr: read the shared graph). Arc activations must
+    // reach them through PricingReplicas::publishArcStates.
+    void setReplicas(PricingReplicas* replicas);
+
+    // Restarts of call k are seeded with k (counting from 1); this makes the next call
+    // draw the restarts of call number call, e.g. to replay a recorded call reproducibly
+    void setNextSeedCall(uint64_t call) { nextSeedCall_ = call; }
+
+    std::string getName() const override { return name_; }
+    double price(const std::vector<double>& duals, std::vector<Column>& columns) override;
+    double getMultiplicity() const override { return params_.multiplicity; }
+
+    GraspStats getStats() const;
+};
+
+#endif // GRASP_PRICER_HPP
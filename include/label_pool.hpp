@@ -0,0 +1,97 @@
+#ifndef LABEL_POOL_HPP
+#define LABEL_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct LabelPoolStats {
+    uint64_t slabs = 0;
+    uint64_t reservedBytes = 0;         // Slab memory held (kept across resets)
+    uint64_t liveLabels = 0;            // Allocated and not released since the last reset
+    uint64_t peakLabels = 0;            // Highest liveLabels ever
+    uint64_t allocations = 0;
+    uint64_t releases = 0;
+    uint64_t resets = 0;
+};
+
+// Slab allocator for fixed-size labels of a labeling algorithm. A record is the label
+// header (a trivially destructible struct of headerBytes) followed by bitsetWords inline
+// 64-bit words (e.g. visited customers), so a label is one allocation that never touches
+// the heap. Records are carved from large slabs; released records go to a free list, and
+// reset() frees every label at once by rewinding the slabs, which stay reserved for the
+// next pricing call. Record addresses are stable until they are released or reset.
+// Not thread-safe: every thread uses its own pool (see LabelPools).
+class LabelPool {
+private:
+    size_t bitsetOffset_;               // Bytes from the record start to the bitset
+    size_t recordBytes_;
+    int bitsetWords_;
+    size_t recordsPerSlab_;
+
+    std::vector<std::unique_ptr<char[]>> slabs_;
+    size_t slab_;                       // Slab records are carved from
+    size_t next_;                       // Next unused record in that slab
+    void* freeList_;                    // Released records, linked through their first bytes
+    LabelPoolStats stats_;
+
+public:
+    LabelPool(size_t headerBytes, size_t headerAlignment, int bitsetWords,
+              size_t slabBytes = size_t(1) << 20);
+
+    LabelPool(const LabelPool&) = delete;
+    LabelPool& operator=(const LabelPool&) = delete;
+
+    // Uninitialized record; the header is constructed by the caller (placement or
+    // assignment), the bitset is zeroed
+    void* allocate();
+    void release(void* record);
+
+    // Release every label (no destructors run)
+    void reset();
+
+    uint64_t* getBitset(void* record) const {
+        return reinterpret_cast<uint64_t*>(static_cast<char*>(record) + bitsetOffset_);
+    }
+    const uint64_t* getBitset(const void* record) const {
+        return reinterpret_cast<const uint64_t*>(static_cast<const char*>(record) + bitsetOffset_);
+    }
+    int getBitsetWords() const { return bitsetWords_; }
+    size_t getRecordBytes() const { return recordBytes_; }
+    const LabelPoolStats& getStats() const { return stats_; }
+};
+
+// One LabelPool per thread for pricing oracles that label in parallel: local() returns
+// the calling thread's pool, created on first use with the common record layout.
+// resetAll() and getStats() must not run concurrently with labeling.
+class LabelPools {
+private:
+    size_t headerBytes_;
+    size_t headerAlignment_;
+    int bitsetWords_;
+    size_t slabBytes_;
+    uint64_t serial_;                   // Identifies this object in thread-local caches
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::thread::id, std::unique_ptr<LabelPool>> pools_;
+
+public:
+    LabelPools(size_t headerBytes, size_t headerAlignment, int bitsetWords,
+               size_t slabBytes = size_t(1) << 20);
+
+    LabelPools(const LabelPools&) = delete;
+    LabelPools& operator=(const LabelPools&) = delete;
+
+    LabelPool& local();
+    void resetAll();
+
+    // Sum over the threads' pools (peakLabels is the sum of the per-thread peaks)
+    LabelPoolStats getStats() const;
+    int getNumPools() const;
+};
+
+#endif // LABEL_POOL_HPP
@@ -0,0 +1,88 @@
+#ifndef LABELING_PRICER_HPP
+#define LABELING_PRICER_HPP
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "label_pool.hpp"
+#include "pricing_graph.hpp"
+#include "pricing_oracle.hpp"
+
+struct LabelingParams {
+    int maxColumns = 50;                // Most negative routes returned per call
+    size_t maxLabels = size_t(1) << 22; // Labels per call; beyond, the call is heuristic
+    bool elementary = true;             // ESPPRC; false allows cycles (a relaxation)
+    // Cost per unit of route duration (sink arrival minus source departure). The source
+    // departure is then chosen freely in the source time window, so labels carry their
+    // arrival time as a function of it instead of a single earliest time.
+    double durationCost = 0.0;
+    double multiplicity = std::numeric_limits<double>::infinity();   // Vehicles available
+    double tolerance = 1e-6;
+};
+
+struct LabelingStats {
+    uint64_t calls = 0;
+    uint64_t labels = 0;                // Created, including dominated ones
+    uint64_t dominated = 0;
+    uint64_t truncated = 0;             // Calls stopped by maxLabels
+    uint64_t functionPoints = 0;        // Breakpoints of arrival-time functions created
+};
+
+// Resource-constrained shortest path pricing on a PricingGraph: mono-directional label
+// setting with capacity, time windows and (by default) elementarity. Every path from
+// source to sink is a column covering the rows of its customers plus the convexity row.
+//
+// Time-dependent arcs are handled natively through PricingGraph::getArrivalTime. With
+// FIFO travel times the earliest arrival dominates later ones, so a label keeps a single
+// time; only when durationCost is set does a label carry a piecewise-linear arrival-time
+// function over the source departure window, composed with the arc functions on every
+// extension.
+// Labels are records of a LabelPool with the visited bitset inline: rejected and
+// dominated labels go back to its free list, and every call starts with a bulk reset.
+class LabelingPricer : public PricingOracle {
+private:
+    // Header of a pool record; the visited bitset (elementary pricing) follows inline
+    struct Label {
+        int node;
+        int arc;                        // Arc that reached the node (-1 at the source)
+        const Label* parent;            // Predecessor (nullptr at the source)
+        double cost;                    // Reduced cost so far, without the duration term
+        double load;
+        double time;                    // Earliest service start at the node
+        int functionStart;              // Arrival-time function breakpoints (duration pricing)
+        int functionSize;
+        bool dominated;
+    };
+
+    const PricingGraph& graph_;         // Non-owning reference
+    LabelingParams params_;
+    std::string name_;
+    LabelingStats stats_;
+
+    LabelPool pool_;                            // Labels of the current call
+    std::vector<std::vector<Label*>> buckets_;  // Undominated labels per node
+    std::vector<double> functionX_;             // Source departure times
+    std::vector<double> functionY_;             // Service start at the label's node
+
+    bool usesFunctions() const { return params_.durationCost > 0.0; }
+    bool extend(const Label& label, int arc, double reducedCost, Label& next);
+    bool extendFunction(const Label& label, int arc, Label& next);
+    bool dominates(const Label& a, const Label& b) const;
+    bool insert(Label* label);                  // False (and released) if dominated
+    double getDuration(const Label& label) const;
+    Column makeColumn(const Label* label, const std::vector<double>& duals) const;
+
+public:
+    explicit LabelingPricer(const PricingGraph& graph, const LabelingParams& params = LabelingParams(),
+                            const std::string& name = "labeling");
+
+    std::string getName() const override { return name_; }
+    double price(const std::vector<double>& duals, std::vector<Column>& columns) override;
+    double getMultiplicity() const override { return params_.multiplicity; }
+
+    const LabelingStats& getStats() const { return stats_; }
+    const LabelPoolStats& getPoolStats() const { return pool_.getStats(); }
+};
+
+#endif // LABELING_PRICER_HPP
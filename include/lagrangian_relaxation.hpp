@@ -0,0 +1,78 @@
+#ifndef LAGRANGIAN_RELAXATION_HPP
+#define LAGRANGIAN_RELAXATION_HPP
+
+#include <vector>
+#include "scip_solver.hpp"
+
+// Result of a Lagrangian master engine (duals plus an approximate primal)
+struct LagrangianSolution {
+    std::vector<double> duals;      // One per row: change of the bound per unit change of the row side
+    std::vector<double> primal;     // Approximate primal value per column
+    double dualBound = 0.0;         // Best Lagrangian bound (lower bound when minimizing)
+    double primalObjective = 0.0;   // Objective of the primal estimate
+    double maxViolation = 0.0;      // Largest row violation of the primal estimate
+    int iterations = 0;
+    bool converged = false;
+};
+
+// Relaxes every row of a ScipSolver model into the objective; columns keep their bounds.
+// Works on the same ScipConstraint / ScipVariable handles as the LP master, internally
+// as a minimization. Column bounds must be finite (CG masters are usually within [0, 1]).
+class LagrangianRelaxation {
+private:
+    SCIP* scip_;                          // Non-owning reference
+    double sense_;                        // +1 minimize, -1 maximize
+    std::vector<ScipConstraint*> rows_;
+    std::vector<ScipVariable*> columns_;
+
+    std::vector<double> lhs_;
+    std::vector<double> rhs_;
+    std::vector<double> cost_;            // Already multiplied by sense_
+    std::vector<double> lb_;
+    std::vector<double> ub_;
+
+    // Column-major copy of the rows
+    std::vector<int> colStart_;
+    std::vector<int> rowIndex_;
+    std::vector<double> values_;
+
+    bool isFinite(double value) const;
+
+public:
+    LagrangianRelaxation(ScipSolver& solver,
+                         const std::vector<ScipConstraint*>& rows,
+                         const std::vector<ScipVariable*>& columns);
+
+    // Register a column created after construction (e.g. by pricing) and re-read the rows
+    void addColumn(ScipVariable* column);
+
+    // Re-read bounds, costs and row coefficients from the SCIP handles
+    void reload();
+
+    int getNumRows() const { return static_cast<int>(rows_.size()); }
+    int getNumColumns() const { return static_cast<int>(columns_.size()); }
+    double getSense() const { return sense_; }
+
+    // Clip duals to the sign allowed by each row (>= rows: nonnegative, <= rows: nonpositive)
+    void projectDuals(std::vector<double>& duals) const;
+
+    // Same sign restrictions as box bounds (±std::numeric_limits<double>::infinity())
+    void dualBounds(std::vector<double>& lower, std::vector<double>& upper) const;
+
+    // Minimize the Lagrangian over the column box; returns L(duals), x receives the minimizer
+    double evaluate(const std::vector<double>& duals, std::vector<double>& x) const;
+
+    // Subgradient of L at duals for the primal point x (side minus activity, per row)
+    void subgradient(const std::vector<double>& duals, const std::vector<double>& x,
+                     std::vector<double>& g) const;
+
+    // Objective and largest row violation of a primal point
+    double primalObjective(const std::vector<double>& x) const;
+    double maxViolation(const std::vector<double>& x) const;
+
+    // Convert internal (minimization) duals and bounds to the model's sense
+    void toModelSense(std::vector<double>& duals) const;
+    std::vector<double> fromModelSense(const std::vector<double>& duals) const;
+};
+
+#endif // LAGRANGIAN_RELAXATION_HPP
@@ -0,0 +1,62 @@
+#ifndef MEMOIZED_ORACLE_HPP
+#define MEMOIZED_ORACLE_HPP
+
+#include <string>
+#include <vector>
+#include "pricing_oracle.hpp"
+
+struct MemoizationParams {
+    double reducedCostTolerance = 1e-6;
+    double reuseDrift = 0.1;            // Re-price cached columns while the drift stays below
+    int maxCachedColumns = 1000;        // Candidates kept from the last real pricing call
+};
+
+struct MemoizationStats {
+    int calls = 0;
+    int solved = 0;                     // Calls forwarded to the wrapped oracle
+    int skipped = 0;                    // Proven to have no negative column
+    int reused = 0;                     // Answered from cached candidates
+};
+
+// Memoizing decorator of an exact pricing oracle. For a column with coefficients a,
+// rc(pi') = rc(pi) - sum_i (pi'_i - pi_i) a_i, so with |a_i| <= maxCoef_i the smallest
+// reduced cost moves by at most drift = sum_i |pi'_i - pi_i| * maxCoef_i from the duals
+// of the last real call. A call is skipped when lastBound - drift >= -tolerance, and
+// answered from the cached candidates when the drift is small and some of them still
+// price out; both return lastBound - drift, which stays a valid lower bound.
+class MemoizedOracle : public PricingOracle {
+private:
+    PricingOracle& inner_;              // Non-owning reference
+    std::vector<double> maxCoefficients_;   // Per master row; empty = uniformCoefficient_
+    double uniformCoefficient_;
+    MemoizationParams params_;
+    MemoizationStats stats_;
+
+    bool valid_;                        // Anchor holds an exact (finite) bound
+    std::vector<double> anchorDuals_;
+    double anchorBound_;
+    std::vector<Column> cache_;
+
+    double drift(const std::vector<double>& duals) const;
+    static double reducedCost(const Column& column, const std::vector<double>& duals);
+
+public:
+    // Per-row bounds on |coefficient| over every column the wrapped oracle can produce
+    MemoizedOracle(PricingOracle& inner, const std::vector<double>& maxCoefficients,
+                   const MemoizationParams& params = MemoizationParams());
+
+    // Same bound for every row (e.g. 1 for set-partitioning columns)
+    MemoizedOracle(PricingOracle& inner, double maxCoefficient,
+                   const MemoizationParams& params = MemoizationParams());
+
+    std::string getName() const override { return inner_.getName(); }
+    double price(const std::vector<double>& duals, std::vector<Column>& columns) override;
+    double getMultiplicity() const override { return inner_.getMultiplicity(); }
+
+    // Forget the anchor, e.g. after the master rows or the subproblem changed
+    void invalidate();
+
+    const MemoizationStats& getStats() const { return stats_; }
+};
+
+#endif // MEMOIZED_ORACLE_HPP
@@ -0,0 +1,97 @@
+#ifndef MPI_PRICING_HPP
+#define MPI_PRICING_HPP
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mpi.h>
+#include <vector>
+#include "pricing_oracle.hpp"
+
+struct MpiPricingParams {
+    int batches = 4;            // Gathers per round; batch b+1 is priced while b is in flight
+};
+
+struct MpiPricingStats {
+    int rounds = 0;
+    long columnsReceived = 0;
+    long bytesReceived = 0;
+    double waitTime = 0.0;      // Seconds rank 0 spent blocked on communication
+};
+
+// Distributed pricing over MPI. Rank 0 owns the master and drives the rounds; worker
+// ranks own the subproblems (round-robin) and sit in serve(). Every round rank 0
+// broadcasts the duals with MPI_Bcast; workers price their subproblems in batches and
+// return columns with MPI_Igather/MPI_Igatherv per batch, so the transfer of one batch
+// overlaps with pricing the next and rank 0 unpacks while later batches arrive.
+// With a single rank everything is priced locally. All ranks construct the object
+// collectively with the same arguments.
+class MpiPricing {
+private:
+    class Proxy : public PricingOracle {
+    private:
+        MpiPricing& owner_;
+        int subproblem_;
+
+    public:
+        Proxy(MpiPricing& owner, int subproblem) : owner_(owner), subproblem_(subproblem) {}
+        std::string getName() const override { return "mpi_" + std::to_string(subproblem_); }
+        double price(const std::vector<double>& duals, std::vector<Column>& columns) override;
+        double getMultiplicity() const override;
+    };
+
+    struct Result {
+        std::vector<Column> columns;
+        double bound = 0.0;
+        bool taken = true;
+    };
+
+    MPI_Comm comm_;
+    int rank_;
+    int size_;
+    int numRows_;
+    int numSubproblems_;
+    std::vector<double> multiplicities_;
+    MpiPricingParams params_;
+
+    std::vector<int> owned_;                                 // Subproblems of this rank
+    std::vector<std::unique_ptr<PricingOracle>> oracles_;    // Parallel to owned_
+    std::vector<std::unique_ptr<Proxy>> proxies_;            // Rank 0
+    std::vector<Result> results_;                           // Rank 0
+    std::vector<double> roundDuals_;
+    MpiPricingStats stats_;
+    bool stopped_;
+
+    int ownerOf(int subproblem) const;
+    void broadcast(std::vector<double>& message);
+    std::vector<char> priceBatch(const std::vector<double>& duals, int batch);
+    int unpack(const char* data, size_t bytes);              // First failed subproblem or -1
+    void runRound(const std::vector<double>& duals);
+    double take(int subproblem, const std::vector<double>& duals, std::vector<Column>& columns);
+
+public:
+    MpiPricing(MPI_Comm comm, int numRows, int numSubproblems,
+               const std::function<std::unique_ptr<PricingOracle>(int)>& factory,
+               const std::vector<double>& multiplicities = {},
+               const MpiPricingParams& params = MpiPricingParams());
+    ~MpiPricing();
+
+    MpiPricing(const MpiPricing&) = delete;
+    MpiPricing& operator=(const MpiPricing&) = delete;
+
+    bool isMaster() const { return rank_ == 0; }
+    int getRank() const { return rank_; }
+
+    // Worker ranks: price rounds until rank 0 calls shutdown()
+    void serve();
+
+    // Rank 0: release the workers (also done by the destructor)
+    void shutdown();
+
+    // Rank 0: one oracle per subproblem for ColumnGeneration
+    PricingOracle& getOracle(int subproblem) { return *proxies_.at(subproblem); }
+    int getNumSubproblems() const { return numSubproblems_; }
+    const MpiPricingStats& getStats() const { return stats_; }
+};
+
+#endif // MPI_PRICING_HPP
@@ -0,0 +1,40 @@
+#ifndef NUMA_TOPOLOGY_HPP
+#define NUMA_TOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+
+// NUMA nodes and their CPUs as reported by /sys/devices/system/node. Falls back to a
+// single node holding every online CPU when the sysfs tree is not available.
+class NumaTopology {
+private:
+    std::vector<std::vector<int>> nodeCpus_;   // CPU ids per node, ascending
+    std::vector<int> cpuNode_;                 // Node per CPU id (-1: offline/unknown)
+
+public:
+    static NumaTopology detect();
+
+    // Build from explicit CPU lists (one entry per node)
+    explicit NumaTopology(const std::vector<std::vector<int>>& nodeCpus);
+
+    int getNumNodes() const { return static_cast<int>(nodeCpus_.size()); }
+    int getNumCpus() const;
+    const std::vector<int>& getCpus(int node) const { return nodeCpus_.at(node); }
+    int getNodeOfCpu(int cpu) const;
+
+    // Node of the CPU the calling thread runs on (0 when unknown)
+    int getCurrentNode() const;
+
+    // CPU for the given worker when workers fill nodes one after another
+    // (wraps around once every CPU is taken)
+    int getCpuForWorker(int worker) const;
+
+    // Parse a sysfs cpulist such as "0-3,8,10-11"
+    static std::vector<int> parseCpuList(const std::string& list);
+};
+
+// Bind the calling thread to one CPU / a set of CPUs; returns false when the OS refuses
+bool pinCurrentThreadToCpu(int cpu);
+bool pinCurrentThreadToCpus(const std::vector<int>& cpus);
+
+#endif // NUMA_TOPOLOGY_HPP
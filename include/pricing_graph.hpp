@@ -0,0 +1,124 @@
+#ifndef PRICING_GRAPH_HPP
+#define PRICING_GRAPH_HPP
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Directed routing network for path pricing (source -> customers -> sink). Every
+// customer node covers one master row; entering it collects that row's dual. Arcs are
+// stored as parallel arrays with CSR out/in adjacency built by finalize().
+// Travel times may depend on the departure time: such arcs keep piecewise-linear
+// breakpoints in one shared array instead of copies per time bucket.
+class PricingGraph {
+public:
+    struct Node {
+        int row = -1;                  // Master row covered by visiting the node (-1: none)
+        double demand = 0.0;
+        double earliest = 0.0;         // Time window
+        double latest = std::numeric_limits<double>::infinity();
+        double service = 0.0;          // Service time spent before leaving the node
+    };
+
+private:
+    std::vector<Node> nodes_;
+    int source_;
+    int sink_;
+    int convexityRow_;                 // Master row whose dual is paid once per path (-1: none)
+    double capacity_;
+
+    std::vector<int> tail_;
+    std::vector<int> head_;
+    std::vector<double> cost_;
+    std::vector<double> travelTime_;
+    std::vector<char> active_;
+
+    // Time-dependent travel times: breakpoints of all arcs back to back
+    std::vector<int> ttfStart_;        // Per arc: first breakpoint (-1: static travel time)
+    std::vector<int> ttfSize_;
+    std::vector<double> ttfDeparture_;
+    std::vector<double> ttfDuration_;
+
+    std::vector<int> outStart_;
+    std::vector<int> outArcs_;
+    std::vector<int> inStart_;
+    std::vector<int> inArcs_;
+    bool finalized_;
+
+public:
+    PricingGraph(int numNodes, int source, int sink);
+
+    Node& node(int i) { return nodes_.at(i); }
+    const Node& node(int i) const { return nodes_.at(i); }
+
+    void setConvexityRow(int row) { convexityRow_ = row; }
+    int getConvexityRow() const { return convexityRow_; }
+    void setCapacity(double capacity) { capacity_ = capacity; }
+    double getCapacity() const { return capacity_; }
+
+    // Arcs can only be added before finalize()
+    int addArc(int tail, int head, double cost, double travelTime);
+    void finalize();
+    bool isFinalized() const { return finalized_; }
+
+    int getNumNodes() const { return static_cast<int>(nodes_.size()); }
+    int getNumArcs() const { return static_cast<int>(tail_.size()); }
+    int getSource() const { return source_; }
+    int getSink() const { return sink_; }
+
+    int getTail(int arc) const { return tail_[arc]; }
+    int getHead(int arc) const { return head_[arc]; }
+    double getCost(int arc) const { return cost_[arc]; }
+    double getTravelTime(int arc) const { return travelTime_[arc]; }
+    bool isActive(int arc) const { return active_[arc] != 0; }
+    void setActive(int arc, bool active) { active_[arc] = active ? 1 : 0; }
+    int getNumActiveArcs() const;
+
+    // Piecewise-linear travel time of an arc: durations[k] when leaving at departures[k]
+    // (strictly ascending), linear in between and constant outside. The function must be
+    // FIFO (leaving later never arrives earlier, i.e. slopes >= -1). The static travel
+    // time becomes the smallest duration, so eliminateArcs stays a valid relaxation.
+    // Replacing a function leaves its old breakpoints unused in the shared array.
+    void setTravelTimeFunction(int arc, const std::vector<double>& departures,
+                               const std::vector<double>& durations);
+    bool isTimeDependent(int arc) const {
+        return arc < static_cast<int>(ttfStart_.size()) && ttfStart_[arc] >= 0;
+    }
+    int getNumBreakpoints(int arc) const { return isTimeDependent(arc) ? ttfSize_[arc] : 0; }
+    size_t getNumBreakpoints() const { return ttfDeparture_.size(); }
+    const double* getBreakpointDepartures(int arc) const {
+        return isTimeDependent(arc) ? ttfDeparture_.data() + ttfStart_[arc] : nullptr;
+    }
+    const double* getBreakpointDurations(int arc) const {
+        return isTimeDependent(arc) ? ttfDuration_.data() + ttfStart_[arc] : nullptr;
+    }
+
+    // Arrival at the head when leaving the tail at departure (non-decreasing in departure)
+    double getArrivalTime(int arc, double departure) const;
+
+    // Arc ids leaving / entering a node as [first, last) ranges (after finalize)
+    std::pair<const int*, const int*> outArcs(int node) const {
+        return {outArcs_.data() + outStart_[node], outArcs_.data() + outStart_[node + 1]};
+    }
+    std::pair<const int*, const int*> inArcs(int node) const {
+        return {inArcs_.data() + inStart_[node], inArcs_.data() + inStart_[node + 1]};
+    }
+
+    // Arc cost minus the dual of the row covered by its head
+    double getReducedCost(int arc, const std::vector<double>& duals) const;
+
+    // Dual paid once per path (convexity), zero if there is none
+    double getPathDual(const std::vector<double>& duals) const;
+
+    // Reduced-cost arc elimination. With masterObjective/duals from an optimal restricted
+    // master, multiplicity the number of paths a solution may use and incumbent a feasible
+    // integer value, an arc is removed when every path through it has so large a reduced
+    // cost that any solution using it costs more than the incumbent. Path bounds come from
+    // forward/backward time-resource labeling without elementarity or capacity, so arc
+    // durations (service + travel time) must be positive. Returns the arcs deactivated.
+    std::vector<int> eliminateArcs(const std::vector<double>& duals, double masterObjective,
+                                   double multiplicity, double incumbent);
+};
+
+#endif // PRICING_GRAPH_HPP
@@ -0,0 +1,26 @@
+#ifndef PRICING_ORACLE_HPP
+#define PRICING_ORACLE_HPP
+
+#include <limits>
+#include <string>
+#include <vector>
+#include "column.hpp"
+
+// Interface of a pricing subproblem: given the master duals, propose columns
+class PricingOracle {
+public:
+    virtual ~PricingOracle() = default;
+
+    virtual std::string getName() const = 0;
+
+    // Append candidate columns priced against duals (one dual per master row).
+    // Returns a lower bound on the smallest reduced cost of any column this oracle
+    // can generate, or -infinity when the oracle is heuristic.
+    virtual double price(const std::vector<double>& duals, std::vector<Column>& columns) = 0;
+
+    // Largest total value the oracle's columns can take in a master solution
+    // (e.g. the convexity right-hand side); infinity when unknown.
+    virtual double getMultiplicity() const { return std::numeric_limits<double>::infinity(); }
+};
+
+#endif // PRICING_ORACLE_HPP
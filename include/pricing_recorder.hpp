@@ -0,0 +1,161 @@
+#ifndef PRICING_RECORDER_HPP
+#define PRICING_RECORDER_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "pricing_oracle.hpp"
+
+// Branching decision in force while pricing: bounds on an entity the caller defines
+// (an orbit sum of a block column, an arc, a pair of rows, ...)
+struct RecordedBound {
+    int index = 0;
+    double lower = 0.0;
+    double upper = 0.0;
+};
+
+// Branch-and-price node the following pricing calls belong to
+struct PricingBranchingState {
+    int64_t node = 0;                   // 0 = root
+    std::vector<RecordedBound> bounds;  // Decisions on the path from the root
+};
+
+// One pricing call read back from a log
+struct RecordedPricingCall {
+    uint64_t sequence = 0;              // Call number in the log
+    int oracle = 0;                     // Index into PricingReplay::getOracleNames()
+    int state = 0;                      // Index into PricingReplay::getStates()
+    std::vector<double> duals;
+    std::vector<Column> columns;        // As returned (reduced costs included)
+    double bound = 0.0;                 // Returned lower bound (-infinity: heuristic)
+    double seconds = 0.0;               // Wall time of the recorded call
+};
+
+struct PricingRecorderStats {
+    uint64_t calls = 0;
+    uint64_t columns = 0;
+    uint64_t sparseDuals = 0;           // Calls stored as a change list against the previous duals
+    uint64_t bytes = 0;
+};
+
+// Compact binary log of pricing calls. Every call stores the duals, the columns and
+// bound the oracle returned and its wall time; the duals are stored as the entries that
+// changed since the previous call when that is shorter. Oracle names and branching
+// states are written once and referenced by index. Numbers are stored in the host's
+// byte order, so logs are read back on the same kind of machine. Thread-safe.
+class PricingRecorder {
+private:
+    std::ofstream out_;
+    std::mutex mutex_;
+    std::string buffer_;                        // Record being encoded
+    std::unordered_map<std::string, int> oracles_;
+    std::vector<double> lastDuals_;
+    PricingBranchingState state_;
+    bool stateWritten_;                         // state_ is in the log already
+    PricingRecorderStats stats_;
+
+    void writeBuffer();
+
+public:
+    explicit PricingRecorder(const std::string& path);
+    ~PricingRecorder();
+
+    PricingRecorder(const PricingRecorder&) = delete;
+    PricingRecorder& operator=(const PricingRecorder&) = delete;
+
+    // State of the calls recorded from now on (e.g. on entering a node)
+    void setBranchingState(const PricingBranchingState& state);
+
+    // Append one call; columns are those the oracle appended
+    void record(const std::string& oracle, const std::vector<double>& duals,
+                const Column* columns, size_t numColumns, double bound, double seconds);
+
+    void flush();
+
+    PricingRecorderStats getStats();
+};
+
+// Decorator that records every call of the wrapped oracle and otherwise stays invisible
+class RecordingOracle : public PricingOracle {
+private:
+    PricingOracle& inner_;              // Non-owning references
+    PricingRecorder& recorder_;
+
+public:
+    RecordingOracle(PricingOracle& inner, PricingRecorder& recorder)
+        : inner_(inner), recorder_(recorder) {}
+
+    std::string getName() const override { return inner_.getName(); }
+    double price(const std::vector<double>& duals, std::vector<Column>& columns) override;
+    double getMultiplicity() const override { return inner_.getMultiplicity(); }
+};
+
+struct ReplayParams {
+    std::string oracle;                 // Replay only calls recorded for this oracle ("" = all)
+    int repetitions = 1;                // Runs per call; the fastest is reported
+    size_t maxCalls = 0;                // 0 = all
+};
+
+struct ReplayCallResult {
+    uint64_t sequence = 0;
+    int64_t node = 0;
+    int recordedColumns = 0;
+    int columns = 0;
+    double recordedBestReducedCost = 0.0;   // 0 when no column was returned
+    double bestReducedCost = 0.0;
+    double recordedBound = 0.0;
+    double bound = 0.0;
+    double recordedSeconds = 0.0;
+    double seconds = 0.0;
+};
+
+struct ReplaySummary {
+    int calls = 0;
+    double recordedSeconds = 0.0;
+    double seconds = 0.0;
+    int boundChanges = 0;               // Calls whose bound differs from the recording
+    int reducedCostChanges = 0;         // Calls whose best reduced cost differs
+};
+
+// Loads a pricing log and re-runs an oracle over its calls in recorded order, without a
+// master: each call gets the recorded duals and is timed on its own. A branching handler
+// is called before the first call of every state so the oracle can be put into it.
+// Stateful oracles (GRASP seeds from its call count, a MemoizedOracle answers repeats
+// from its cache) answer repetitions and filtered replays differently unless a reset
+// handler, called before every timed run, puts them back into the state of that call.
+class PricingReplay {
+private:
+    std::vector<std::string> oracleNames_;
+    std::vector<PricingBranchingState> states_;
+    std::vector<RecordedPricingCall> calls_;
+    std::function<void(const PricingBranchingState&)> branchingHandler_;
+    std::function<void(const RecordedPricingCall&)> resetHandler_;
+
+public:
+    explicit PricingReplay(const std::string& path);
+
+    void setBranchingHandler(std::function<void(const PricingBranchingState&)> handler) {
+        branchingHandler_ = std::move(handler);
+    }
+
+    // E.g. GraspPricer::setNextSeedCall(call.sequence + 1) or MemoizedOracle::invalidate()
+    void setResetHandler(std::function<void(const RecordedPricingCall&)> handler) {
+        resetHandler_ = std::move(handler);
+    }
+
+    std::vector<ReplayCallResult> run(PricingOracle& oracle,
+                                      const ReplayParams& params = ReplayParams());
+
+    static ReplaySummary summarize(const std::vector<ReplayCallResult>& results,
+                                   double tolerance = 1e-6);
+
+    const std::vector<std::string>& getOracleNames() const { return oracleNames_; }
+    const std::vector<PricingBranchingState>& getStates() const { return states_; }
+    const std::vector<RecordedPricingCall>& getCalls() const { return calls_; }
+};
+
+#endif // PRICING_RECORDER_HPP
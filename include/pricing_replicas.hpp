@@ -0,0 +1,79 @@
+#ifndef PRICING_REPLICAS_HPP
+#define PRICING_REPLICAS_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "numa_topology.hpp"
+#include "pricing_graph.hpp"
+
+// Read-only pricing data of one NUMA node
+struct PricingReplica {
+    int node = 0;
+    uint64_t epoch = 0;                     // Publication the duals belong to
+    PricingGraph graph;
+    std::vector<double> duals;
+    std::vector<double> arcReducedCosts;    // graph.getReducedCost(arc, duals) per arc
+    double pathDual = 0.0;
+
+    explicit PricingReplica(const PricingGraph& source) : graph(source) {}
+};
+
+// One copy of the pricing graph, the duals and the arc reduced-cost matrix per NUMA
+// node. Every replica is built and refreshed by a persistent thread bound to its node,
+// so the first-touch policy places its pages in that node's memory and pricing workers
+// (pinned by TaskScheduler) read only local memory. Scheduler tasks cannot be bound to
+// a node, hence the dedicated threads. Publishing is not concurrent with readers or
+// with itself: call it between pricing rounds.
+class PricingReplicas {
+private:
+    NumaTopology topology_;
+    std::vector<std::unique_ptr<PricingReplica>> replicas_;
+    uint64_t epoch_;
+
+    // One thread per node (none on a single node), woken for every forEachNode call
+    std::vector<std::thread> nodeThreads_;
+    std::mutex jobMutex_;
+    std::condition_variable jobReady_;
+    std::condition_variable jobDone_;
+    const std::function<void(int)>* job_;
+    uint64_t jobGeneration_;
+    int jobsPending_;
+    bool stopNodes_;
+    std::vector<std::exception_ptr> errors_;
+
+    void nodeLoop(int node);
+    void stopNodeThreads();
+
+    // Run fn(node) for every node on the thread bound to that node's CPUs
+    void forEachNode(const std::function<void(int)>& fn);
+
+public:
+    explicit PricingReplicas(const PricingGraph& graph,
+                             const NumaTopology& topology = NumaTopology::detect());
+    ~PricingReplicas();
+
+    PricingReplicas(const PricingReplicas&) = delete;
+    PricingReplicas& operator=(const PricingReplicas&) = delete;
+
+    // Copy the new duals into every replica and recompute its arc reduced costs
+    void publishDuals(const std::vector<double>& duals);
+
+    // Propagate arc (de)activations, e.g. after PricingGraph::eliminateArcs on the master copy
+    void publishArcStates(const PricingGraph& graph);
+
+    // Replica of the node the calling thread runs on
+    const PricingReplica& local() const;
+    const PricingReplica& getReplica(int node) const { return *replicas_.at(node); }
+
+    int getNumReplicas() const { return static_cast<int>(replicas_.size()); }
+    uint64_t getEpoch() const { return epoch_; }
+    const NumaTopology& getTopology() const { return topology_; }
+};
+
+#endif // PRICING_REPLICAS_HPP
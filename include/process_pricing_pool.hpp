@@ -0,0 +1,100 @@
+#ifndef PROCESS_PRICING_POOL_HPP
+#define PROCESS_PRICING_POOL_HPP
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+#include "pricing_oracle.hpp"
+
+// One pricing subproblem run in its own process. The factory is called inside the
+// worker process, so non-reentrant libraries are initialized there and never shared.
+struct PricingWorkerSpec {
+    std::string name;
+    double multiplicity = std::numeric_limits<double>::infinity();
+    std::function<std::unique_ptr<PricingOracle>()> factory;
+};
+
+struct ProcessPoolParams {
+    size_t ringBytes = size_t(1) << 20;     // Column ring per worker
+    double timeoutSeconds = 0.0;            // Per pricing round; 0 = no limit
+    int maxRestarts = 10;                   // Per worker over the pool's lifetime
+};
+
+struct ProcessPoolStats {
+    int rounds = 0;
+    int restarts = 0;
+    long columnsReceived = 0;
+};
+
+// Pricing workers as forked processes. Duals go to every worker through a POSIX
+// shared-memory segment, workers stream columns back through a single-producer ring
+// buffer each, and request/response hand-offs use process-shared futexes. A worker that
+// crashes or times out is killed and re-forked, and its subproblem priced again once.
+// Each worker appears to ColumnGeneration as its own PricingOracle (getOracle); the
+// first of them called with new duals prices all workers in parallel.
+// Fork from a process without running threads where possible.
+class ProcessPricingPool {
+private:
+    struct Channel;                          // Lives in shared memory
+
+    class Proxy : public PricingOracle {
+    private:
+        ProcessPricingPool& pool_;
+        int worker_;
+
+    public:
+        Proxy(ProcessPricingPool& pool, int worker) : pool_(pool), worker_(worker) {}
+        std::string getName() const override;
+        double price(const std::vector<double>& duals, std::vector<Column>& columns) override;
+        double getMultiplicity() const override;
+    };
+
+    struct Worker {
+        PricingWorkerSpec spec;
+        pid_t pid = -1;
+        int restarts = 0;
+        Channel* channel = nullptr;
+        double* duals = nullptr;
+        unsigned char* ring = nullptr;
+        std::vector<Column> columns;         // Result of the current round
+        double bound = 0.0;
+        bool taken = true;                   // Result handed to ColumnGeneration
+        std::unique_ptr<Proxy> proxy;
+    };
+
+    int numRows_;
+    ProcessPoolParams params_;
+    void* memory_;
+    size_t memoryBytes_;
+    size_t channelBytes_;
+    std::vector<Worker> workers_;
+    std::vector<double> roundDuals_;
+    ProcessPoolStats stats_;
+
+    void spawn(int worker);
+    void stop(int worker);
+    void drainRing(Worker& worker);
+    std::vector<int> runRound(const std::vector<int>& workers);   // Returns restarted workers
+    void priceAll(const std::vector<double>& duals);
+    double take(int worker, const std::vector<double>& duals, std::vector<Column>& columns);
+
+    [[noreturn]] static void workerMain(Worker& worker, int numRows, size_t ringBytes);
+
+public:
+    ProcessPricingPool(int numRows, const std::vector<PricingWorkerSpec>& workers,
+                       const ProcessPoolParams& params = ProcessPoolParams());
+    ~ProcessPricingPool();
+
+    ProcessPricingPool(const ProcessPricingPool&) = delete;
+    ProcessPricingPool& operator=(const ProcessPricingPool&) = delete;
+
+    int getNumWorkers() const { return static_cast<int>(workers_.size()); }
+    PricingOracle& getOracle(int worker) { return *workers_.at(worker).proxy; }
+    pid_t getWorkerPid(int worker) const { return workers_.at(worker).pid; }
+    const ProcessPoolStats& getStats() const { return stats_; }
+};
+
+#endif // PROCESS_PRICING_POOL_HPP
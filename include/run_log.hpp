@@ -0,0 +1,111 @@
+#ifndef RUN_LOG_HPP
+#define RUN_LOG_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum class RunLogEvent : uint16_t {
+    Iteration = 0,              // One column generation round
+    Finished                    // End of a column generation run
+};
+
+// Fixed-size binary record; 64 bytes so one ring slot is one cache line
+struct RunLogRecord {
+    double time = 0.0;                  // Seconds since the log started (set by write)
+    RunLogEvent event = RunLogEvent::Iteration;
+    uint16_t thread = 0;                // Writer's ring (set by write)
+    int32_t iteration = 0;
+    int32_t columnsAdded = 0;           // This iteration (Finished: whole run)
+    int32_t columns = 0;                // Master columns afterwards
+    int32_t optimal = 0;                // Finished: no improving column left
+    double objective = 0.0;             // Restricted master LP value
+    double bound = 0.0;                 // Best Lagrangian bound so far
+    double masterSeconds = 0.0;         // Cumulative over the run
+    double pricingSeconds = 0.0;
+};
+
+struct RunLogParams {
+    size_t ringCapacity = 4096;         // Records per writer thread (rounded to a power of two)
+    double flushInterval = 0.2;         // Seconds between background exports
+};
+
+struct RunLogStats {
+    uint64_t written = 0;               // Records exported
+    uint64_t dropped = 0;               // Lost because a ring was full
+    uint64_t flushes = 0;
+    uint64_t bytes = 0;                 // JSON bytes written
+};
+
+// Structured run log for hot loops. Every writer thread owns a single-producer ring of
+// binary records, so write() is a few stores and never blocks, formats or allocates
+// (a full ring drops the record and counts it). A background thread drains the rings
+// every flushInterval, orders the batch by time and appends it as JSON Lines, one
+// object per record, to a file or stream; the destructor exports what is left.
+class RunLog {
+private:
+    struct Ring {
+        std::unique_ptr<RunLogRecord[]> records;
+        alignas(64) std::atomic<uint64_t> head{0};      // Next write (producer)
+        alignas(64) std::atomic<uint64_t> tail{0};      // Next read (consumer)
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    std::string run_;                   // Tag of every exported line
+    RunLogParams params_;
+    uint64_t mask_;
+    uint64_t serial_;                   // Identifies this log in thread-local caches
+    std::chrono::steady_clock::time_point start_;
+    std::unique_ptr<std::ofstream> file_;
+    std::ostream* out_;
+
+    mutable std::mutex ringsMutex_;     // Ring registration
+    std::vector<std::unique_ptr<Ring>> rings_;
+    std::unordered_map<std::thread::id, uint16_t> ringIndex_;  // Writer thread -> its ring
+    mutable std::mutex exportMutex_;    // One consumer at a time
+    std::vector<RunLogRecord> batch_;
+    RunLogStats stats_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    bool stop_;
+    std::thread flusher_;
+
+    Ring& localRing(uint16_t& index);
+    void flusherLoop();
+    void start();
+
+public:
+    // Append to a JSON Lines file
+    explicit RunLog(const std::string& path, const std::string& run = "",
+                    const RunLogParams& params = RunLogParams());
+    // Export to a stream that outlives the log
+    explicit RunLog(std::ostream& out, const std::string& run = "",
+                    const RunLogParams& params = RunLogParams());
+    ~RunLog();
+
+    RunLog(const RunLog&) = delete;
+    RunLog& operator=(const RunLog&) = delete;
+
+    // Hot path, any thread; false if the record was dropped
+    bool write(RunLogRecord record);
+
+    // Export everything written so far (blocks until done)
+    void flush();
+
+    RunLogStats getStats() const;
+
+    // One JSON object (no newline); non-finite numbers become null
+    static std::string toJson(const RunLogRecord& record, const std::string& run = "");
+};
+
+#endif // RUN_LOG_HPP
@@ -0,0 +1,89 @@
+#ifndef SCENARIO_SOLVER_HPP
+#define SCENARIO_SOLVER_HPP
+
+#include <atomic>
+#include <limits>
+#include <string>
+#include <vector>
+#include "scip_solver.hpp"
+
+// One variant of the base model. Indices refer to the variable and row lists given
+// to ScenarioSolver; everything not listed keeps its base value.
+struct Scenario {
+    struct RowChange {
+        int row;
+        double lhs;
+        double rhs;
+    };
+    struct BoundChange {
+        int variable;
+        double lb;
+        double ub;
+    };
+    struct ObjectiveChange {
+        int variable;
+        double obj;
+    };
+
+    std::string name;
+    std::vector<RowChange> rows;
+    std::vector<BoundChange> bounds;
+    std::vector<ObjectiveChange> objectives;
+};
+
+struct ScenarioResult {
+    std::string name;
+    bool ok = false;                    // False: see error
+    std::string error;
+    SCIP_STATUS status = SCIP_STATUS_UNKNOWN;
+    double objective = 0.0;
+    double dualBound = 0.0;
+    double seconds = 0.0;               // Solve time inside the worker
+    int worker = -1;
+    std::vector<double> values;         // Per variable of the list (collectValues)
+};
+
+struct ScenarioParams {
+    int numWorkers = 0;                 // Processes; 0 = hardware threads
+    double timeLimit = std::numeric_limits<double>::infinity();     // Seconds per scenario
+    bool collectValues = true;
+};
+
+struct ScenarioStats {
+    int scenarios = 0;
+    int solved = 0;
+    int failed = 0;
+    int workers = 0;
+    double wallTime = 0.0;
+    double solveTime = 0.0;             // Sum over workers
+};
+
+// Solves many variants of one model in forked worker processes. The base model is
+// built once in the parent; fork() gives every worker a copy-on-write view of it, so
+// only the pages a worker touches are copied and no SCIP instance is ever shared
+// between threads. Workers claim scenarios from a shared counter, apply the changes,
+// solve, restore the base values and stream results back through a pipe each.
+// Fork from a process without running threads where possible.
+class ScenarioSolver {
+private:
+    ScipSolver& base_;                          // Non-owning reference
+    std::vector<ScipVariable*> variables_;
+    std::vector<ScipConstraint*> rows_;
+    ScenarioParams params_;
+    ScenarioStats stats_;
+
+    [[noreturn]] void runWorker(const std::vector<Scenario>& scenarios, std::atomic<int>* next,
+                                int fd);
+
+public:
+    ScenarioSolver(ScipSolver& base, const std::vector<ScipVariable*>& variables,
+                   const std::vector<ScipConstraint*>& rows,
+                   const ScenarioParams& params = ScenarioParams());
+
+    // One result per scenario, in input order
+    std::vector<ScenarioResult> solve(const std::vector<Scenario>& scenarios);
+
+    const ScenarioStats& getStats() const { return stats_; }
+};
+
+#endif // SCENARIO_SOLVER_HPP
@@ -40,6 +40,14 @@ public:
     // Get constraint name
     std::string getName() const;
 
+    // Left and right hand sides (±SCIPinfinity when absent)
+    double getLhs() const;
+    double getRhs() const;
+
+    // Change the sides (problem stage only)
+    void setLhs(double lhs);
+    void setRhs(double rhs);
+
     // Add a variable to constraint (for column generation)
     void addVariable(ScipVariable* variable, double coefficient);
 
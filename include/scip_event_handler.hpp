@@ -0,0 +1,92 @@
+#ifndef SCIP_EVENT_HANDLER_HPP
+#define SCIP_EVENT_HANDLER_HPP
+
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <scip/scip.h>
+#include "scip_solver.hpp"
+
+enum class ScipEventKind {
+    LpSolved = 0,           // Every LP solve, including the first of a node
+    NodeSolved,             // Node feasible, infeasible or branched
+    BestSolutionFound,      // New incumbent
+    VariableDeleted         // Transformed variable removed (e.g. by column management)
+};
+
+// What a callback sees; query anything else directly on scip
+struct ScipEvent {
+    ScipEventKind kind;
+    SCIP* scip;
+    SCIP_SOL* solution = nullptr;       // BestSolutionFound
+    SCIP_NODE* node = nullptr;          // NodeSolved
+    SCIP_VAR* variable = nullptr;       // VariableDeleted (transformed variable)
+};
+
+using ScipEventCallback = std::function<void(const ScipEvent&)>;
+
+// C++ callbacks on SCIP events during SCIPsolve. Only kinds with a callback are caught,
+// so SCIP never dispatches events nobody listens to; a caught event costs one switch
+// and one std::function call. Callbacks are set in the problem stage and take effect
+// at the next solve. A callback that throws interrupts the solve; the exception is kept
+// and rethrown by rethrowIfFailed().
+// SCIP plugins cannot be removed, so the destructor only detaches the object: the
+// SCIP-side handler stays included and is reused by a later ScipEventHandler with the
+// same name on the same solver (e.g. after ScipSolver::reset).
+class ScipEventHandler {
+private:
+    static constexpr int kNumKinds = 4;
+
+    SCIP* scip_;                                        // Non-owning reference
+    SCIP_EVENTHDLR* handler_;
+    std::array<ScipEventCallback, kNumKinds> callbacks_;
+    std::array<uint64_t, kNumKinds> counts_;
+    SCIP_EVENTTYPE globalMask_;                         // Caught on the whole solve
+    int globalFilter_;                                  // -1 when not caught
+    std::unordered_map<SCIP_VAR*, int> varFilters_;     // VARDELETED catches
+    std::exception_ptr error_;
+
+    static SCIP_RETCODE eventInit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr);
+    static SCIP_RETCODE eventExit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr);
+    static SCIP_RETCODE eventExec(SCIP* scip, SCIP_EVENTHDLR* eventhdlr, SCIP_EVENT* event,
+                                  SCIP_EVENTDATA* eventdata);
+
+    SCIP_RETCODE catchAll();
+    SCIP_RETCODE dropAll();
+    void dispatch(ScipEventKind kind, const ScipEvent& event);
+
+public:
+    explicit ScipEventHandler(ScipSolver& solver, const std::string& name = "cpp_events");
+    ~ScipEventHandler();
+
+    // No copying (SCIP holds a pointer to this object)
+    ScipEventHandler(const ScipEventHandler&) = delete;
+    ScipEventHandler& operator=(const ScipEventHandler&) = delete;
+
+    // An empty callback stops catching the kind
+    void setCallback(ScipEventKind kind, ScipEventCallback callback);
+    void onLpSolved(ScipEventCallback callback) {
+        setCallback(ScipEventKind::LpSolved, std::move(callback));
+    }
+    void onNodeSolved(ScipEventCallback callback) {
+        setCallback(ScipEventKind::NodeSolved, std::move(callback));
+    }
+    void onBestSolutionFound(ScipEventCallback callback) {
+        setCallback(ScipEventKind::BestSolutionFound, std::move(callback));
+    }
+    void onVariableDeleted(ScipEventCallback callback) {
+        setCallback(ScipEventKind::VariableDeleted, std::move(callback));
+    }
+
+    // Events delivered since construction
+    uint64_t getCount(ScipEventKind kind) const { return counts_[static_cast<int>(kind)]; }
+
+    // Rethrow the first exception a callback threw (and clear it)
+    void rethrowIfFailed();
+};
+
+#endif // SCIP_EVENT_HANDLER_HPP
@@ -37,6 +37,32 @@ public:
     void solve();
     SCIP_STATUS getStatus() const;
     double getObjectiveValue() const;
+
+    // Return to the problem stage so variables/constraints can be added again
+    void freeTransform();
+
+    // Drop the problem and reset all parameters, keeping the included plugins, so the
+    // instance can be reused for a new model. Wrappers of the old model must be gone.
+    void reset(const std::string& name = "problem");
+
+    // Wall-clock limit of the next solves in seconds (infinity = none)
+    void setTimeLimit(double seconds);
+    double getSolvingTime() const;
+    double getDualBound() const;
+
+    // Settings for an LP master whose duals are read between solves
+    // (no presolving, heuristics or separation; quiet output)
+    void setColumnGenerationMode();
+
+    // SCIP symmetry handling in MIP solves ("misc/usesymmetry"): 0 = off, 1 = symmetry
+    // constraints (orbitopes, symresacks), 2 = orbital reduction, 3 = both
+    void setSymmetryHandling(int mode);
+
+    // Display verbosity (0 = quiet, 4 = SCIP default)
+    void setVerbosity(int level);
+
+    // Bulk dual read: one value per row, in the given order
+    std::vector<double> getDualValues(const std::vector<ScipConstraint*>& rows) const;
     
     // Variable factory
     ScipVariable createVariable(const std::string& name,
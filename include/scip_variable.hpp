@@ -35,6 +35,18 @@ public:
     
     // Get name (optional)
     std::string getName() const;
+
+    // Objective coefficient and original bounds
+    double getObjective() const;
+    double getLowerBound() const;
+    double getUpperBound() const;
+    SCIP_VARTYPE getType() const;
+
+    // Change the objective coefficient (problem stage only)
+    void setObjective(double obj);
+
+    // Change both bounds (problem stage only)
+    void setBounds(double lb, double ub);
 };
 
 #endif // SCIP_VARIABLE_HPP
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef SIFTING_SOLVER_HPP
+#define SIFTING_SOLVER_HPP
+
+#include <vector>
+#include "column_generation.hpp"
+#include "column_store.hpp"
+
+struct SiftingParams {
+    int columnsPerIteration = 1000;     // Store columns moved into the working set per round
+    int seedColumnsPerRow = 1;          // Cheapest covering columns per row in the first working set
+    int maxIterations = 1000;
+    double reducedCostTolerance = 1e-6;
+    bool verbose = false;
+};
+
+// Sifting: all columns live in a ColumnStore, the SCIP master only holds a working set
+// that grows with the most negative reduced-cost columns of each store scan.
+class SiftingSolver {
+private:
+    const ColumnStore& store_;          // Non-owning reference
+    SiftingParams params_;
+    ColumnStorePricer pricer_;
+    ColumnGeneration cg_;
+
+public:
+    // rows are the master rows, in the same order as the store's row indices
+    SiftingSolver(ScipSolver& master, const std::vector<ScipConstraint*>& rows,
+                  const ColumnStore& store, const SiftingParams& params = SiftingParams());
+
+    // Load, for every row, the seedColumnsPerRow cheapest store columns covering it
+    void seedWorkingSet();
+
+    ColumnGenerationStats solve();
+
+    ColumnStorePricer& getPricer() { return pricer_; }
+    ColumnGeneration& getColumnGeneration() { return cg_; }
+    int getWorkingSetSize() const { return cg_.getNumColumns(); }
+};
+
+#endif // SIFTING_SOLVER_HPP
@@ -0,0 +1,88 @@
+#ifndef SOLUTION_POOL_HPP
+#define SOLUTION_POOL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "scip_solver.hpp"
+#include "scip_event_handler.hpp"
+
+// One stored solution restricted to a variable list, kept sparse
+struct ScipSolution {
+    double objective = 0.0;
+    double time = 0.0;                  // Solving time in seconds when it was found
+    std::vector<int> indices;           // Ascending positions in the variable list
+    std::vector<double> values;         // Nonzero values, parallel to indices
+
+    // Value of the variable at a list position (0 if not stored)
+    double getValue(int index) const;
+};
+
+// Read-only view of SCIP's solution pool, best solution first. Values are read for the
+// given variables with one SCIPgetSolVals call per solution. The view is valid until
+// the transformed problem is freed.
+class ScipSolutionPool {
+private:
+    SCIP* scip_;                                // Non-owning reference
+    mutable std::vector<SCIP_VAR*> vars_;       // Mutable: SCIPgetSolVals takes SCIP_VAR**
+    double zeroTolerance_;
+    mutable std::vector<double> buffer_;        // Dense values of one solution
+
+public:
+    class const_iterator {
+    private:
+        const ScipSolutionPool* pool_;
+        size_t index_;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ScipSolution;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const ScipSolution*;
+        using reference = ScipSolution;
+
+        const_iterator(const ScipSolutionPool* pool, size_t index) : pool_(pool), index_(index) {}
+        ScipSolution operator*() const { return pool_->getSolution(index_); }
+        const_iterator& operator++() { ++index_; return *this; }
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+    };
+
+    ScipSolutionPool(ScipSolver& solver, const std::vector<ScipVariable*>& variables,
+                     double zeroTolerance = 1e-9);
+
+    size_t size() const;
+    ScipSolution getSolution(size_t index) const;
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    // Sparse extraction of any SCIP solution (e.g. one delivered by an event)
+    ScipSolution extract(SCIP_SOL* solution) const;
+};
+
+using IncumbentCallback = std::function<void(const ScipSolution&)>;
+
+// Delivers every new incumbent while SCIP is still solving, as soon as it is found.
+// The callback runs inside SCIPsolve on the solving thread: hand the solution to
+// another thread for anything slow.
+class IncumbentStream {
+private:
+    ScipSolutionPool pool_;
+    ScipEventHandler events_;
+    IncumbentCallback callback_;
+    int delivered_;
+
+public:
+    IncumbentStream(ScipSolver& solver, const std::vector<ScipVariable*>& variables,
+                    IncumbentCallback callback, const std::string& name = "incumbent_stream");
+
+    int getNumDelivered() const { return delivered_; }
+
+    // Rethrow an exception thrown by the callback (it interrupted the solve)
+    void rethrowIfFailed() { events_.rethrowIfFailed(); }
+};
+
+#endif // SOLUTION_POOL_HPP
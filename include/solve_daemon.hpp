@@ -0,0 +1,179 @@
+#ifndef SOLVE_DAEMON_HPP
+#define SOLVE_DAEMON_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "scip_solver.hpp"
+#include "solver_metrics.hpp"
+
+// One job of the daemon protocol. A job is a block of text lines:
+//
+//   job <id>
+//   timelimit <seconds>
+//   sense min|max
+//   var <name> <lb> <ub> <obj> [int]
+//   row <name> <lhs> <rhs> <var>:<coef> ...
+//   column <cost> <row>:<coef> ...          (priceable columns; turns the job into CG)
+//   pricing max_columns=<n> tolerance=<t>
+//   end
+//
+// Bounds and sides accept inf/-inf. Without column lines the model is solved directly;
+// with them the rows form a CG master (minimization) priced from a ColumnStore.
+struct SolveJob {
+    struct Variable {
+        std::string name;
+        double lb = 0.0;
+        double ub = std::numeric_limits<double>::infinity();
+        double obj = 0.0;
+        bool integer = false;
+    };
+    struct Row {
+        std::string name;
+        double lhs = -std::numeric_limits<double>::infinity();
+        double rhs = std::numeric_limits<double>::infinity();
+        std::vector<std::pair<std::string, double>> terms;
+    };
+    struct PricedColumn {
+        double cost = 0.0;
+        std::vector<std::pair<std::string, double>> entries;    // Row name, coefficient
+    };
+
+    std::string id;
+    double timeLimit = std::numeric_limits<double>::infinity();
+    bool maximize = false;
+    std::vector<Variable> variables;
+    std::vector<Row> rows;
+    std::vector<PricedColumn> columns;
+    int maxColumnsPerIteration = 100;
+    double reducedCostTolerance = 1e-6;
+};
+
+struct JobResult {
+    std::string id;
+    std::string status;             // optimal, infeasible, unbounded, timelimit, ...
+    double objective = 0.0;
+    double bound = 0.0;
+    double seconds = 0.0;
+    int iterations = 0;             // CG iterations (0 for direct solves)
+    int columnsAdded = 0;
+    std::vector<std::pair<std::string, double>> values;     // Nonzero variables
+};
+
+struct DaemonParams {
+    int numSolvers = 4;                 // Warm ScipSolver instances = concurrent jobs
+    size_t maxQueuedJobs = 1024;        // Further jobs are rejected
+    double defaultTimeLimit = 60.0;     // Seconds, for jobs without a timelimit line
+    size_t latencyWindow = 10000;       // Recent jobs used for the latency percentiles
+    std::string metricsPath;            // Prometheus text file rewritten periodically ("" = none)
+    double metricsInterval = 10.0;      // Seconds between metrics file rewrites
+};
+
+struct DaemonStats {
+    uint64_t accepted = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    uint64_t rejected = 0;
+    double uptime = 0.0;                // Seconds
+    double throughput = 0.0;            // Completed jobs per second of uptime
+    double meanLatency = 0.0;           // Submission to result, seconds
+    double p50Latency = 0.0;
+    double p95Latency = 0.0;
+    double maxLatency = 0.0;
+    double meanQueueWait = 0.0;
+};
+
+// Long-running batch solver on a Unix domain socket. Clients send job blocks (see
+// SolveJob) and receive "accepted", "started", "result", "value" and "done" lines per
+// job, or "error"/"rejected". The command "stats" returns one stats line and "shutdown"
+// stops the daemon. Jobs run on a fixed pool of ScipSolver instances whose plugins are
+// included once at startup and which are reset between jobs. With a metrics path, job
+// counters, queue length, busy solvers and the column generation metrics of the jobs
+// are exported as a Prometheus text file.
+class SolveDaemon {
+private:
+    struct Connection;
+
+    // Metric slots of the daemon itself (job CG metrics are registered by ColumnGeneration)
+    struct MetricIds {
+        int accepted = -1;
+        int rejected = -1;
+        int completed = -1;
+        int failed = -1;
+        int jobSeconds = -1;
+        int queued = -1;
+        int busy = -1;
+    };
+
+    struct PendingJob {
+        std::shared_ptr<Connection> connection;
+        SolveJob job;
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    std::string socketPath_;
+    DaemonParams params_;
+    int listenFd_;
+    std::atomic<bool> stop_;
+    std::chrono::steady_clock::time_point started_;
+
+    mutable std::mutex queueMutex_;
+    std::condition_variable queueReady_;
+    std::deque<PendingJob> queue_;
+
+    std::vector<std::thread> workers_;
+    std::mutex readersMutex_;
+    std::map<uint64_t, std::thread> readers_;      // One per open connection
+    std::vector<uint64_t> finishedReaders_;         // Returned, joined by run() on its next tick
+    uint64_t nextReader_;
+
+    mutable std::mutex statsMutex_;
+    DaemonStats counters_;
+    std::vector<double> latencies_;     // Ring of the last latencyWindow jobs
+    size_t latencyNext_;
+    double queueWaitTotal_;
+
+    std::unique_ptr<SolverMetrics> metrics_;    // Null without metricsPath
+    MetricIds metricIds_;
+
+    void workerLoop(int worker);
+    void serveConnection(std::shared_ptr<Connection> connection);
+    void reapReaders();
+    void handleBlock(const std::shared_ptr<Connection>& connection,
+                     const std::vector<std::string>& lines);
+    void recordJob(double latency, double queueWait, bool failed);
+    std::string formatStats() const;
+
+public:
+    explicit SolveDaemon(const std::string& socketPath, const DaemonParams& params = DaemonParams());
+    ~SolveDaemon();
+
+    SolveDaemon(const SolveDaemon&) = delete;
+    SolveDaemon& operator=(const SolveDaemon&) = delete;
+
+    // Accept connections until stop() (or a client's "shutdown")
+    void run();
+    void stop();
+
+    DaemonStats getStats() const;
+
+    // Protocol pieces, usable without a socket
+    static SolveJob parseJob(const std::vector<std::string>& lines);
+    // Column generation metrics go to metrics with the given labels (see
+    // ColumnGeneration::setMetrics); the daemon labels them by solver
+    static JobResult execute(ScipSolver& solver, const SolveJob& job,
+                             SolverMetrics* metrics = nullptr, const std::string& metricLabels = "");
+    static std::vector<std::string> formatResult(const JobResult& result);
+};
+
+#endif // SOLVE_DAEMON_HPP
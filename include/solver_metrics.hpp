@@ -0,0 +1,93 @@
+#ifndef SOLVER_METRICS_HPP
+#define SOLVER_METRICS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum class MetricType {
+    Counter,                    // Only grows (totals)
+    Gauge                       // Current value
+};
+
+// Counters and gauges of a long-running solve, exported in the Prometheus text format
+// for a file scraper (e.g. the node_exporter textfile collector). Metrics are registered
+// up front and live in a fixed array of cache-line sized atomic slots, so set() and
+// add() are single atomic operations that never lock or allocate; only registration and
+// export take a lock. A background thread can rewrite the file periodically; the file
+// is replaced atomically (write to a temporary, then rename).
+class SolverMetrics {
+private:
+    struct alignas(64) Slot {
+        std::atomic<double> value{0.0};
+    };
+
+    struct Info {
+        std::string name;
+        std::string help;
+        std::string labels;     // Prometheus label list without braces, e.g. oracle="grasp"
+        MetricType type;
+    };
+
+    size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<int> size_;
+
+    mutable std::mutex mutex_;                  // Registration and export
+    std::vector<Info> info_;
+    std::unordered_map<std::string, int> index_;    // name{labels} -> metric
+    int residentMemory_;                        // Refreshed on every export
+
+    std::string path_;                          // Background writer target
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    bool stop_;
+    std::thread writer_;
+
+    int registerMetric(const std::string& name, const std::string& help,
+                       const std::string& labels, MetricType type);
+
+public:
+    explicit SolverMetrics(size_t capacity = 256);
+    ~SolverMetrics();
+
+    SolverMetrics(const SolverMetrics&) = delete;
+    SolverMetrics& operator=(const SolverMetrics&) = delete;
+
+    // Register (or find, when name and labels are known) a metric; returns its slot.
+    // Names follow Prometheus rules; counters should end in _total.
+    int addCounter(const std::string& name, const std::string& help, const std::string& labels = "");
+    int addGauge(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    // Hot path, any thread
+    void set(int metric, double value) {
+        slots_[metric].value.store(value, std::memory_order_relaxed);
+    }
+    void add(int metric, double delta) {
+        std::atomic<double>& value = slots_[metric].value;
+        double current = value.load(std::memory_order_relaxed);
+        while (!value.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+        }
+    }
+    double get(int metric) const { return slots_[metric].value.load(std::memory_order_relaxed); }
+
+    int getNumMetrics() const { return size_.load(std::memory_order_acquire); }
+
+    // Text exposition format, metrics grouped by name in registration order
+    std::string format();
+
+    // Replace the file with the current values
+    void writeFile(const std::string& path);
+
+    // Rewrite the file every interval seconds in a background thread until stop()
+    void start(const std::string& path, double interval = 10.0);
+    void stop();                    // Writes a final snapshot
+};
+
+#endif // SOLVER_METRICS_HPP
@@ -0,0 +1,154 @@
+#ifndef TASK_SCHEDULER_HPP
+#define TASK_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "numa_topology.hpp"
+
+// Within one worker, higher priorities are always taken (and stolen) first
+enum class TaskPriority {
+    High = 0,       // e.g. pricing on the critical path of a CG iteration
+    Normal = 1,     // separation, pool scans
+    Low = 2         // primal heuristics, background work
+};
+
+struct SchedulerParams {
+    int numThreads = 0;         // 0 = one worker per CPU
+    bool pinThreads = true;     // Pin workers to CPUs, filling NUMA nodes in order
+    int spinRounds = 64;        // Failed steal rounds before a worker sleeps
+};
+
+struct SchedulerStats {
+    uint64_t executed = 0;
+    uint64_t stolen = 0;        // Tasks taken from another worker's deque
+};
+
+// Completion counter for a set of tasks; wait() rethrows the first task exception
+class TaskGroup {
+private:
+    std::atomic<int> pending_{0};
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+
+    friend class TaskScheduler;
+
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    bool isDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+};
+
+struct Task {
+    std::function<void()> function;
+    TaskGroup* group;
+};
+
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient Work-Stealing for
+// Weak Memory Models"). Only the owner pushes and takes at the bottom; any thread may
+// steal from the top. Retired buffers are kept until destruction.
+class ChaseLevDeque {
+private:
+    struct Buffer {
+        int64_t capacity;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+
+        explicit Buffer(int64_t cap) : capacity(cap), slots(new std::atomic<Task*>[cap]) {}
+        Task* get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, Task* task) { slots[i & (capacity - 1)].store(task, std::memory_order_relaxed); }
+    };
+
+    alignas(64) std::atomic<int64_t> top_;
+    alignas(64) std::atomic<int64_t> bottom_;
+    std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;     // Owner only
+
+public:
+    explicit ChaseLevDeque(int64_t capacity = 256);
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    void push(Task* task);          // Owner
+    Task* take();                   // Owner; nullptr when empty
+    Task* steal();                  // Any thread; nullptr when empty or lost a race
+
+    bool isEmpty() const;
+};
+
+// Work-stealing scheduler shared by pricing, separation, pool scans and heuristics.
+// Every worker owns one deque per priority; tasks submitted from a worker go to its own
+// deque, tasks from other threads to an injection queue. Idle workers steal from workers
+// on their own NUMA node before crossing nodes. Threads blocked in wait() help execute.
+class TaskScheduler {
+private:
+    struct alignas(64) Worker {
+        ChaseLevDeque deques[3];
+        std::vector<int> victims;   // Same-node workers first
+        int cpu = -1;
+        int node = 0;
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> stolen{0};
+        std::thread thread;
+    };
+
+    SchedulerParams params_;
+    NumaTopology topology_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex injectMutex_;
+    std::deque<Task*> injected_[3];
+    std::atomic<int64_t> injectedCount_{0};    // Lets workers skip the lock when empty
+
+    std::atomic<int64_t> queued_{0};    // Submitted but not started
+    std::atomic<int> sleepers_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> stop_{false};
+
+    void workerLoop(int index);
+    Task* findTask(int worker);
+    Task* stealFrom(int thief, const std::vector<int>& victims, int priority);
+    void run(Task* task);
+
+public:
+    explicit TaskScheduler(const SchedulerParams& params = SchedulerParams());
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // Scheduler shared by every feature of the process (created on first use)
+    static TaskScheduler& shared();
+
+    void submit(TaskGroup& group, std::function<void()> function,
+                TaskPriority priority = TaskPriority::Normal);
+
+    // Block until every task of the group finished, executing tasks meanwhile
+    void wait(TaskGroup& group);
+
+    // Run body(chunkBegin, chunkEnd) over [begin, end) in chunks of at most grain. The
+    // caller executes chunks while it waits, so up to getNumWorkers() + 1 threads run body.
+    void parallelFor(size_t begin, size_t end, size_t grain,
+                     const std::function<void(size_t, size_t)>& body,
+                     TaskPriority priority = TaskPriority::Normal);
+
+    int getNumWorkers() const { return static_cast<int>(workers_.size()); }
+    int getWorkerNode(int worker) const { return workers_.at(worker)->node; }
+    const NumaTopology& getTopology() const { return topology_; }
+    SchedulerStats getStats() const;
+
+    // Index of the calling thread among this scheduler's workers, -1 otherwise
+    int getCurrentWorker() const;
+};
+
+#endif // TASK_SCHEDULER_HPP
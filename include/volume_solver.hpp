@@ -0,0 +1,45 @@
+#ifndef VOLUME_SOLVER_HPP
+#define VOLUME_SOLVER_HPP
+
+#include <vector>
+#include "lagrangian_relaxation.hpp"
+
+// Tuning knobs of the volume algorithm (Barahona & Anbil)
+struct VolumeParams {
+    int maxIterations = 2000;
+    double stepFactor = 0.1;         // lambda: step length multiplier
+    double minStepFactor = 5e-4;
+    double alphaMax = 0.1;           // Upper bound on the primal averaging weight
+    int redStepLimit = 20;           // Consecutive non-improving steps before shrinking lambda
+    double targetGap = 0.05;         // Relative distance of the target value above the bound
+    double primalTolerance = 0.02;   // Max row violation accepted for convergence
+    double gapTolerance = 0.01;      // Relative gap between bound and primal objective
+};
+
+// Approximate master engine: near-optimal duals and primal estimates without an LP solve.
+// Meant for the first phase of large CG runs before switching to the exact ScipSolver master.
+class VolumeSolver {
+private:
+    LagrangianRelaxation relaxation_;
+    VolumeParams params_;
+
+public:
+    VolumeSolver(ScipSolver& solver,
+                 const std::vector<ScipConstraint*>& rows,
+                 const std::vector<ScipVariable*>& columns,
+                 const VolumeParams& params = VolumeParams());
+
+    void setParams(const VolumeParams& params) { params_ = params; }
+    const VolumeParams& getParams() const { return params_; }
+
+    // Columns priced in after construction (their rows must already contain them)
+    void addColumn(ScipVariable* column) { relaxation_.addColumn(column); }
+
+    // Re-read the model, e.g. after ScipConstraint::addVariable on existing columns
+    void reload() { relaxation_.reload(); }
+
+    // Run the volume algorithm; initialDuals (model sense) warm-starts from a previous run
+    LagrangianSolution solve(const std::vector<double>& initialDuals = {});
+};
+
+#endif // VOLUME_SOLVER_HPP
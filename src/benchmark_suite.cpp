@@ -0,0 +1,310 @@
+#include "../include/benchmark_suite.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Runs of one family: instance -> repetition -> record
+typedef std::map<std::string, std::map<int, BenchmarkRecord>> FamilyRuns;
+
+std::map<std::string, FamilyRuns> groupByFamily(const std::vector<BenchmarkRecord>& records) {
+    std::map<std::string, FamilyRuns> families;
+    for (const BenchmarkRecord& record : records) {
+        families[record.family][record.instance][record.repetition] = record;
+    }
+    return families;
+}
+
+// Acklam's rational approximation of the standard normal quantile
+double normalQuantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    if (p < 0.02425) {
+        const double q = std::sqrt(-2.0 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+               / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    if (p > 1.0 - 0.02425) {
+        return -normalQuantile(1.0 - p);
+    }
+    const double q = p - 0.5;
+    const double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+           / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+// Student t quantile: exact for one and two degrees of freedom, Cornish-Fisher
+// expansion (Abramowitz-Stegun 26.7.5) above. Welch degrees of freedom in (1, 2) get the
+// one-degree quantile: wider than exact, never too narrow.
+double studentQuantile(double p, double df) {
+    if (df < 2.0) {
+        return std::tan(M_PI * (p - 0.5));
+    }
+    if (df == 2.0) {
+        return (2.0 * p - 1.0) / std::sqrt(2.0 * p * (1.0 - p));
+    }
+    const double z = normalQuantile(p);
+    const double z2 = z * z;
+    const double g1 = (z2 + 1.0) * z / 4.0;
+    const double g2 = ((5.0 * z2 + 16.0) * z2 + 3.0) * z / 96.0;
+    const double g3 = (((3.0 * z2 + 19.0) * z2 + 17.0) * z2 - 15.0) * z / 384.0;
+    const double g4 = ((((79.0 * z2 + 776.0) * z2 + 1482.0) * z2 - 1920.0) * z2 - 945.0) * z / 92160.0;
+    return z + g1 / df + g2 / (df * df) + g3 / (df * df * df) + g4 / (df * df * df * df);
+}
+
+// Mean over the instances of log(x + shift), one value per repetition that every given
+// instance has
+std::vector<double> logMeans(const FamilyRuns& runs, const std::vector<std::string>& instances,
+                             bool seconds, double shift) {
+    std::map<int, std::pair<double, size_t>> sums;
+    for (const std::string& instance : instances) {
+        for (const auto& entry : runs.at(instance)) {
+            const double value = seconds ? entry.second.seconds : entry.second.iterations;
+            auto& sum = sums[entry.first];
+            sum.first += std::log(std::max(value, 0.0) + shift);
+            ++sum.second;
+        }
+    }
+    std::vector<double> means;
+    for (const auto& entry : sums) {
+        if (entry.second.second == instances.size()) {
+            means.push_back(entry.second.first / instances.size());
+        }
+    }
+    return means;
+}
+
+void meanAndVariance(const std::vector<double>& values, double& mean, double& variance) {
+    mean = 0.0;
+    for (double value : values) {
+        mean += value / values.size();
+    }
+    variance = 0.0;
+    for (double value : values) {
+        variance += (value - mean) * (value - mean);
+    }
+    variance = values.size() > 1 ? variance / (values.size() - 1) : 0.0;
+}
+
+// One repetition gives the point estimate only
+MeanEstimate estimate(const std::vector<double>& logs, double shift, double confidence) {
+    MeanEstimate result;
+    if (logs.empty()) {
+        result.value = result.lower = result.upper = std::numeric_limits<double>::quiet_NaN();
+        return result;
+    }
+    double mean, variance;
+    meanAndVariance(logs, mean, variance);
+    double half = 0.0;
+    if (logs.size() > 1) {
+        const double n = static_cast<double>(logs.size());
+        half = studentQuantile(0.5 + confidence / 2.0, n - 1.0) * std::sqrt(variance / n);
+    }
+    result.value = std::exp(mean) - shift;
+    result.lower = std::exp(mean - half) - shift;
+    result.upper = std::exp(mean + half) - shift;
+    return result;
+}
+
+// Ratio of the shifted geometric means. The Welch interval of the difference of log means
+// is mapped to ratios with the baseline mean held fixed; it is unbounded without two
+// repetitions on each side, and a point when neither side varies (e.g. deterministic
+// iteration counts).
+RatioEstimate ratio(const std::vector<double>& current, const std::vector<double>& baseline,
+                    double shift, const BenchmarkParams& params) {
+    RatioEstimate result;
+    if (current.empty() || baseline.empty()) {
+        result.ratio = result.lower = result.upper = std::numeric_limits<double>::quiet_NaN();
+        return result;
+    }
+    double meanC, varC, meanB, varB;
+    meanAndVariance(current, meanC, varC);
+    meanAndVariance(baseline, meanB, varB);
+    const double difference = meanC - meanB;
+    const double base = std::exp(meanB) - shift;
+    // Ratio of the means at a log-mean difference d; the shifted one if the baseline mean is 0
+    auto toRatio = [&](double d) {
+        return base > 0.0 ? (std::exp(meanB + d) - shift) / base : std::exp(d);
+    };
+    result.ratio = toRatio(difference);
+
+    const double nC = static_cast<double>(current.size());
+    const double nB = static_cast<double>(baseline.size());
+    const double seC = varC / nC;
+    const double seB = varB / nB;
+    if (current.size() < 2 || baseline.size() < 2) {
+        result.lower = 0.0;
+        result.upper = std::numeric_limits<double>::infinity();
+    } else if (seC + seB == 0.0) {
+        result.lower = result.upper = result.ratio;
+    } else {
+        const double df = (seC + seB) * (seC + seB)
+                          / (seC * seC / (nC - 1.0) + seB * seB / (nB - 1.0));
+        const double half = studentQuantile(0.5 + params.confidence / 2.0, df) * std::sqrt(seC + seB);
+        result.lower = std::max(toRatio(difference - half), 0.0);
+        result.upper = toRatio(difference + half);
+    }
+
+    if (result.lower > 1.0 && result.ratio > 1.0 + params.minChange) {
+        result.verdict = BenchmarkVerdict::Regressed;
+    } else if (result.upper < 1.0 && result.ratio < 1.0 / (1.0 + params.minChange)) {
+        result.verdict = BenchmarkVerdict::Improved;
+    }
+    return result;
+}
+
+// Names are stored as whitespace-separated fields
+bool isWord(const std::string& value) {
+    return !value.empty() && std::none_of(value.begin(), value.end(),
+                                          [](char c) { return std::isspace(static_cast<unsigned char>(c)); });
+}
+
+} // namespace
+
+void BenchmarkSuite::add(const std::string& family, const std::string& instance,
+                         std::function<BenchmarkSample()> run) {
+    if (!isWord(family) || !isWord(instance)) {
+        throw std::runtime_error("Benchmark family and instance names must be non-empty words");
+    }
+    for (const Entry& entry : entries_) {
+        if (entry.family == family && entry.instance == instance) {
+            throw std::runtime_error("Benchmark instance '" + family + "/" + instance + "' added twice");
+        }
+    }
+    entries_.push_back({family, instance, std::move(run)});
+}
+
+std::vector<BenchmarkRecord> BenchmarkSuite::run(const BenchmarkParams& params) const {
+    std::vector<BenchmarkRecord> records;
+    for (int round = -params.warmup; round < params.repetitions; ++round) {
+        for (const Entry& entry : entries_) {
+            const auto start = std::chrono::steady_clock::now();
+            const BenchmarkSample sample = entry.run();
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (round < 0) {
+                continue;
+            }
+            BenchmarkRecord record;
+            record.family = entry.family;
+            record.instance = entry.instance;
+            record.repetition = round;
+            record.seconds = sample.seconds >= 0.0 ? sample.seconds : elapsed;
+            record.iterations = sample.iterations;
+            records.push_back(record);
+            if (params.verbose) {
+                std::cout << entry.family << "/" << entry.instance << " run " << round
+                          << ": " << record.seconds << " s, " << record.iterations
+                          << " iterations" << std::endl;
+            }
+        }
+    }
+    return records;
+}
+
+void BenchmarkSuite::save(const std::string& path, const std::vector<BenchmarkRecord>& records) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open benchmark file '" + path + "'");
+    }
+    out << "# family instance repetition seconds iterations\n" << std::setprecision(17);
+    for (const BenchmarkRecord& record : records) {
+        out << record.family << ' ' << record.instance << ' ' << record.repetition << ' '
+            << record.seconds << ' ' << record.iterations << '\n';
+    }
+    if (!out.flush()) {
+        throw std::runtime_error("Cannot write benchmark file '" + path + "'");
+    }
+}
+
+std::vector<BenchmarkRecord> BenchmarkSuite::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open benchmark file '" + path + "'");
+    }
+    std::vector<BenchmarkRecord> records;
+    std::string line;
+    for (int number = 1; std::getline(in, line); ++number) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        BenchmarkRecord record;
+        if (!(fields >> record.family >> record.instance >> record.repetition
+                     >> record.seconds >> record.iterations)) {
+            throw std::runtime_error("Malformed line " + std::to_string(number) + " in '" + path + "'");
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+std::vector<FamilySummary> BenchmarkSuite::summarize(const std::vector<BenchmarkRecord>& records,
+                                                     const BenchmarkParams& params) {
+    std::vector<FamilySummary> summaries;
+    for (const auto& family : groupByFamily(records)) {
+        std::vector<std::string> instances;
+        for (const auto& instance : family.second) {
+            instances.push_back(instance.first);
+        }
+        const std::vector<double> seconds = logMeans(family.second, instances, true, params.timeShift);
+        const std::vector<double> iterations = logMeans(family.second, instances, false,
+                                                        params.iterationShift);
+        FamilySummary summary;
+        summary.family = family.first;
+        summary.instances = static_cast<int>(instances.size());
+        summary.repetitions = static_cast<int>(seconds.size());
+        summary.seconds = estimate(seconds, params.timeShift, params.confidence);
+        summary.iterations = estimate(iterations, params.iterationShift, params.confidence);
+        summaries.push_back(summary);
+    }
+    return summaries;
+}
+
+std::vector<FamilyComparison> BenchmarkSuite::compare(const std::vector<BenchmarkRecord>& current,
+                                                      const std::vector<BenchmarkRecord>& baseline,
+                                                      const BenchmarkParams& params) {
+    const std::map<std::string, FamilyRuns> currentFamilies = groupByFamily(current);
+    const std::map<std::string, FamilyRuns> baselineFamilies = groupByFamily(baseline);
+    std::vector<FamilyComparison> comparisons;
+    for (const auto& family : currentFamilies) {
+        auto base = baselineFamilies.find(family.first);
+        if (base == baselineFamilies.end()) {
+            continue;
+        }
+        std::vector<std::string> instances;
+        for (const auto& instance : family.second) {
+            if (base->second.count(instance.first) > 0) {
+                instances.push_back(instance.first);
+            }
+        }
+        if (instances.empty()) {
+            continue;
+        }
+        FamilyComparison comparison;
+        comparison.family = family.first;
+        comparison.instances = static_cast<int>(instances.size());
+        comparison.seconds = ratio(logMeans(family.second, instances, true, params.timeShift),
+                                   logMeans(base->second, instances, true, params.timeShift),
+                                   params.timeShift, params);
+        comparison.iterations = ratio(logMeans(family.second, instances, false, params.iterationShift),
+                                      logMeans(base->second, instances, false, params.iterationShift),
+                                      params.iterationShift, params);
+        comparisons.push_back(comparison);
+    }
+    return comparisons;
+}
@@ -0,0 +1,379 @@
+#include "../include/benders_decomposition.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <scip/benders_default.h>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+BendersDecomposition::BendersDecomposition(ScipSolver& master,
+                                           const std::vector<ScipVariable*>& firstStage,
+                                           const BendersParams& params)
+    : master_(master), firstStage_(firstStage), params_(params) {
+    if (SCIPgetObjsense(master_.get()) != SCIP_OBJSENSE_MINIMIZE) {
+        throw std::runtime_error("Benders master must be a minimization problem");
+    }
+    for (const auto* variable : firstStage_) {
+        if (variable == nullptr) {
+            throw std::runtime_error("Null first-stage variable in Benders master");
+        }
+    }
+}
+
+int BendersDecomposition::firstStageIndex(const ScipVariable* variable) const {
+    for (size_t k = 0; k < firstStage_.size(); ++k) {
+        if (firstStage_[k] == variable) {
+            return static_cast<int>(k);
+        }
+    }
+    return -1;
+}
+
+int BendersDecomposition::addSubproblem(ScipSolver& solver,
+                                        const std::vector<ScipConstraint*>& rows,
+                                        const std::vector<ScipVariable*>& columns,
+                                        const std::vector<BendersLink>& links,
+                                        double weight) {
+    if (prepared_ || usedScipFramework_) {
+        throw std::runtime_error("Benders subproblems must be added before solving");
+    }
+    for (const BendersLink& link : links) {
+        if (link.row < 0 || link.row >= static_cast<int>(rows.size())) {
+            throw std::runtime_error("Benders link references unknown subproblem row");
+        }
+        if (firstStageIndex(link.masterVariable) < 0) {
+            throw std::runtime_error("Benders link references a variable that is not first-stage");
+        }
+    }
+
+    auto sub = std::make_unique<Subproblem>();
+    sub->solver = &solver;
+    sub->rows = rows;
+    sub->columns = columns;
+    sub->links = links;
+    sub->weight = weight;
+    subproblems_.push_back(std::move(sub));
+    return static_cast<int>(subproblems_.size()) - 1;
+}
+
+void BendersDecomposition::prepare() {
+    master_.freeTransform();
+    SCIP* scip = master_.get();
+
+    for (size_t s = 0; s < subproblems_.size(); ++s) {
+        Subproblem& sub = *subproblems_[s];
+
+        // 1. Recourse estimate in the master
+        etas_.push_back(master_.createVariable("eta_" + std::to_string(s), params_.etaLowerBound,
+                                               SCIPinfinity(scip), sub.weight));
+        sub.eta = &etas_.back();
+
+        // 2. Subproblem as a dual-producing LP with its x = 0 sides and objectives
+        ScipSolver& solver = *sub.solver;
+        solver.freeTransform();
+        solver.setColumnGenerationMode();
+        SCIP* subScip = solver.get();
+        for (ScipConstraint* row : sub.rows) {
+            sub.lhs.push_back(row->getLhs());
+            sub.rhs.push_back(row->getRhs());
+        }
+        for (ScipVariable* column : sub.columns) {
+            sub.objectives.push_back(column->getObjective());
+        }
+
+        // 3. Elastic columns, fixed to zero outside phase 1
+        for (size_t i = 0; i < sub.rows.size(); ++i) {
+            const std::string name = sub.rows[i]->getName();
+            if (!SCIPisInfinity(subScip, -sub.lhs[i])) {
+                sub.slacks.push_back(solver.createVariable("elastic_lhs_" + name, 0.0, 0.0, 0.0));
+                sub.rows[i]->addVariable(&sub.slacks.back(), 1.0);
+            }
+            if (!SCIPisInfinity(subScip, sub.rhs[i])) {
+                sub.slacks.push_back(solver.createVariable("elastic_rhs_" + name, 0.0, 0.0, 0.0));
+                sub.rows[i]->addVariable(&sub.slacks.back(), -1.0);
+            }
+        }
+    }
+    prepared_ = true;
+}
+
+void BendersDecomposition::shiftSides(Subproblem& sub, const std::vector<double>& point) {
+    SCIP* scip = sub.solver->get();
+    std::vector<double> shift(sub.rows.size(), 0.0);
+    for (const BendersLink& link : sub.links) {
+        shift[link.row] += link.coefficient * point[firstStageIndex(link.masterVariable)];
+    }
+
+    for (size_t i = 0; i < sub.rows.size(); ++i) {
+        ScipConstraint* row = sub.rows[i];
+        const double lhs = SCIPisInfinity(scip, -sub.lhs[i]) ? sub.lhs[i] : sub.lhs[i] - shift[i];
+        const double rhs = SCIPisInfinity(scip, sub.rhs[i]) ? sub.rhs[i] : sub.rhs[i] - shift[i];
+        // Keep lhs <= rhs while moving: lower the side in the direction of the move first
+        if (lhs < row->getLhs()) {
+            row->setLhs(lhs);
+            row->setRhs(rhs);
+        } else {
+            row->setRhs(rhs);
+            row->setLhs(lhs);
+        }
+    }
+}
+
+BendersDecomposition::Evaluation BendersDecomposition::evaluate(Subproblem& sub,
+                                                                 const std::vector<double>& point) {
+    ScipSolver& solver = *sub.solver;
+    SCIP* scip = solver.get();
+    Evaluation result;
+
+    // 1. Second-stage LP at the master point
+    solver.freeTransform();
+    shiftSides(sub, point);
+    solver.solve();
+    SCIP_STATUS status = solver.getStatus();
+
+    if (status == SCIP_STATUS_UNBOUNDED || status == SCIP_STATUS_INFORUNBD) {
+        throw std::runtime_error("Benders subproblem is unbounded");
+    }
+
+    // 2. Infeasible: phase-1 LP minimizing the elastic columns
+    if (status == SCIP_STATUS_INFEASIBLE) {
+        result.feasible = false;
+        solver.freeTransform();
+        for (ScipVariable* column : sub.columns) {
+            column->setObjective(0.0);
+        }
+        for (ScipVariable& slack : sub.slacks) {
+            slack.setBounds(0.0, SCIPinfinity(scip));
+            slack.setObjective(1.0);
+        }
+        solver.solve();
+        status = solver.getStatus();
+    }
+    if (status != SCIP_STATUS_OPTIMAL) {
+        throw std::runtime_error("Benders subproblem not solved to optimality (status "
+                                 + std::to_string(status) + ")");
+    }
+
+    result.value = solver.getObjectiveValue();
+    const std::vector<double> duals = solver.getDualValues(sub.rows);
+    result.cutCoefficients.assign(firstStage_.size(), 0.0);
+    for (const BendersLink& link : sub.links) {
+        result.cutCoefficients[firstStageIndex(link.masterVariable)] += duals[link.row] * link.coefficient;
+    }
+
+    // 3. Restore the phase-2 objective
+    if (!result.feasible) {
+        solver.freeTransform();
+        for (size_t j = 0; j < sub.columns.size(); ++j) {
+            sub.columns[j]->setObjective(sub.objectives[j]);
+        }
+        for (ScipVariable& slack : sub.slacks) {
+            slack.setObjective(0.0);
+            slack.setBounds(0.0, 0.0);
+        }
+    }
+    return result;
+}
+
+BendersStats BendersDecomposition::solve() {
+    if (usedScipFramework_) {
+        throw std::runtime_error("Benders instance already handed to SCIP's Benders framework");
+    }
+    if (subproblems_.empty()) {
+        throw std::runtime_error("Benders decomposition needs at least one subproblem");
+    }
+    if (!prepared_) {
+        prepare();
+    }
+
+    BendersStats stats;
+    stats.upperBound = std::numeric_limits<double>::infinity();
+    const size_t numSubs = subproblems_.size();
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    const size_t numThreads = std::min(numSubs, static_cast<size_t>(
+        params_.numThreads > 0 ? static_cast<unsigned>(params_.numThreads) : hardware));
+
+    std::vector<double> point(firstStage_.size());
+    std::vector<Evaluation> evaluations(numSubs);
+
+    for (stats.iterations = 0; stats.iterations < params_.maxIterations; ++stats.iterations) {
+        // 1. Master
+        auto start = std::chrono::steady_clock::now();
+        master_.solve();
+        stats.masterTime += secondsSince(start);
+        if (master_.getStatus() != SCIP_STATUS_OPTIMAL) {
+            throw std::runtime_error("Benders master not solved to optimality (status "
+                                     + std::to_string(master_.getStatus()) + ")");
+        }
+        stats.lowerBound = master_.getObjectiveValue();
+        for (size_t k = 0; k < firstStage_.size(); ++k) {
+            point[k] = firstStage_[k]->getSolutionValue();
+        }
+        double firstStageCost = stats.lowerBound;
+        for (const auto& sub : subproblems_) {
+            firstStageCost -= sub->weight * sub->eta->getSolutionValue();
+        }
+
+        // 2. Independent subproblems in parallel (each owns its SCIP instance)
+        start = std::chrono::steady_clock::now();
+        std::atomic<size_t> next(0);
+        std::vector<std::exception_ptr> errors(numThreads);
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < numThreads; ++t) {
+            workers.emplace_back([&, t]() {
+                try {
+                    for (size_t s = next++; s < numSubs; s = next++) {
+                        evaluations[s] = evaluate(*subproblems_[s], point);
+                    }
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        stats.subproblemTime += secondsSince(start);
+
+        // 3. Upper bound from a fully feasible second stage
+        bool allFeasible = true;
+        double value = firstStageCost;
+        for (size_t s = 0; s < numSubs; ++s) {
+            allFeasible = allFeasible && evaluations[s].feasible;
+            value += subproblems_[s]->weight * evaluations[s].value;
+        }
+        if (allFeasible) {
+            stats.upperBound = std::min(stats.upperBound, value);
+        }
+
+        if (params_.verbose) {
+            std::cout << "Benders iter " << stats.iterations
+                      << "  lower " << stats.lowerBound
+                      << "  upper " << stats.upperBound << std::endl;
+        }
+        if (std::isfinite(stats.upperBound)
+            && stats.upperBound - stats.lowerBound <= params_.tolerance * (1.0 + std::fabs(stats.upperBound))) {
+            stats.optimal = true;
+            break;
+        }
+
+        // 4. Cuts: eta_s + g.x >= value + g.x_hat (optimality), g.x >= value + g.x_hat (feasibility)
+        std::vector<double> etaValues(numSubs);
+        for (size_t s = 0; s < numSubs; ++s) {
+            etaValues[s] = subproblems_[s]->eta->getSolutionValue();
+        }
+        master_.freeTransform();
+        int added = 0;
+        for (size_t s = 0; s < numSubs; ++s) {
+            Subproblem& sub = *subproblems_[s];
+            const Evaluation& evaluation = evaluations[s];
+            if (evaluation.feasible
+                && evaluation.value <= etaValues[s] + params_.tolerance * (1.0 + std::fabs(evaluation.value))) {
+                continue;
+            }
+
+            std::vector<ScipVariable*> vars;
+            std::vector<double> coeffs;
+            double lhs = evaluation.value;
+            if (evaluation.feasible) {
+                vars.push_back(sub.eta);
+                coeffs.push_back(1.0);
+            }
+            for (size_t k = 0; k < firstStage_.size(); ++k) {
+                const double g = evaluation.cutCoefficients[k];
+                if (g != 0.0) {
+                    vars.push_back(firstStage_[k]);
+                    coeffs.push_back(g);
+                    lhs += g * point[k];
+                }
+            }
+            if (vars.empty()) {
+                throw std::runtime_error("Benders subproblem " + std::to_string(s)
+                                         + " is infeasible for every first-stage decision");
+            }
+
+            const std::string name = (evaluation.feasible ? "benders_opt_" : "benders_feas_")
+                                   + std::to_string(s) + "_" + std::to_string(cuts_.size());
+            cuts_.push_back(master_.createConstraint(name, vars, coeffs, lhs, SCIPinfinity(master_.get())));
+            if (evaluation.feasible) {
+                ++stats.optimalityCuts;
+            } else {
+                ++stats.feasibilityCuts;
+            }
+            ++added;
+        }
+        if (added == 0) {
+            stats.optimal = true;
+            break;
+        }
+    }
+    return stats;
+}
+
+void BendersDecomposition::solveWithScipBenders() {
+    if (prepared_) {
+        throw std::runtime_error("Benders instance already used by the in-house loop");
+    }
+    if (subproblems_.empty()) {
+        throw std::runtime_error("Benders decomposition needs at least one subproblem");
+    }
+
+    // SCIP's default Benders matches master and subproblem variables by name, so every
+    // linked first-stage variable gets a copy inside the subproblem rows
+    std::vector<SCIP*> scips;
+    for (auto& subPtr : subproblems_) {
+        Subproblem& sub = *subPtr;
+        if (sub.weight != 1.0) {
+            throw std::runtime_error("SCIP's Benders framework does not support subproblem weights");
+        }
+        ScipSolver& solver = *sub.solver;
+        solver.freeTransform();
+
+        std::map<const ScipVariable*, ScipVariable*> copies;
+        for (const BendersLink& link : sub.links) {
+            ScipVariable*& copy = copies[link.masterVariable];
+            if (copy == nullptr) {
+                const ScipVariable* original = link.masterVariable;
+                sub.masterCopies.push_back(solver.createVariable(original->getName(),
+                                                                 original->getLowerBound(),
+                                                                 original->getUpperBound(),
+                                                                 0.0, original->getType()));
+                copy = &sub.masterCopies.back();
+            }
+            sub.rows[link.row]->addVariable(copy, link.coefficient);
+        }
+        scips.push_back(solver.get());
+    }
+
+    master_.freeTransform();
+    SCIP_CALL_EXCEPT( SCIPcreateBendersDefault(master_.get(), scips.data(),
+                                               static_cast<int>(scips.size())) );
+    usedScipFramework_ = true;
+    master_.solve();
+}
+
+double BendersDecomposition::getRecourseEstimate(int subproblem) const {
+    const Subproblem& sub = *subproblems_.at(subproblem);
+    if (sub.eta == nullptr) {
+        throw std::runtime_error("Benders master has no recourse estimates yet");
+    }
+    return sub.eta->getSolutionValue();
+}
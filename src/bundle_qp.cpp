@@ -0,0 +1,136 @@
+#include "../include/bundle_qp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+void BundleQp::projectSimplex(std::vector<double>& v) {
+    std::vector<double> sorted(v);
+    std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+
+    double cumulative = 0.0;
+    double theta = 0.0;
+    for (size_t k = 0; k < sorted.size(); ++k) {
+        cumulative += sorted[k];
+        const double candidate = (cumulative - 1.0) / static_cast<double>(k + 1);
+        if (sorted[k] - candidate > 0.0) {
+            theta = candidate;
+        }
+    }
+    for (double& value : v) {
+        value = std::max(value - theta, 0.0);
+    }
+}
+
+void BundleQp::solve(const std::vector<std::vector<double>>& cuts,
+                     const std::vector<double>& alphas,
+                     const std::vector<double>& center,
+                     const std::vector<double>& lower,
+                     const std::vector<double>& upper,
+                     double u,
+                     const std::vector<double>& warmWeights,
+                     double tolerance,
+                     int maxIterations) {
+    const size_t numCuts = cuts.size();
+    const size_t numRows = center.size();
+    if (numCuts == 0 || alphas.size() != numCuts) {
+        throw std::runtime_error("Bundle QP needs at least one cut with matching constants");
+    }
+    if (u <= 0.0) {
+        throw std::runtime_error("Bundle QP proximal weight must be positive");
+    }
+
+    // Lipschitz constant of the dual gradient: ||G||_F^2 / u bounds ||G G^T|| / u
+    double frobenius = 0.0;
+    for (const auto& cut : cuts) {
+        for (double value : cut) {
+            frobenius += value * value;
+        }
+    }
+    const double step = (frobenius > 0.0) ? u / frobenius : 1.0;
+
+    // Inner maximizer for an aggregated subgradient d: pi = clip(center + d / u)
+    std::vector<double> d(numRows);
+    std::vector<double> pi(numRows);
+    auto computePi = [&](const std::vector<double>& lambda) {
+        std::fill(d.begin(), d.end(), 0.0);
+        for (size_t k = 0; k < numCuts; ++k) {
+            if (lambda[k] == 0.0) {
+                continue;
+            }
+            for (size_t i = 0; i < numRows; ++i) {
+                d[i] += lambda[k] * cuts[k][i];
+            }
+        }
+        for (size_t i = 0; i < numRows; ++i) {
+            pi[i] = std::min(upper[i], std::max(lower[i], center[i] + d[i] / u));
+        }
+    };
+
+    // Per-cut values at pi: the dual gradient and, through their minimum, the primal value
+    std::vector<double> cutValues(numCuts);
+    auto evaluateCuts = [&]() {
+        for (size_t k = 0; k < numCuts; ++k) {
+            double value = alphas[k];
+            for (size_t i = 0; i < numRows; ++i) {
+                value += cuts[k][i] * pi[i];
+            }
+            cutValues[k] = value;
+        }
+    };
+    auto proximal = [&]() {
+        double norm2 = 0.0;
+        for (size_t i = 0; i < numRows; ++i) {
+            norm2 += (pi[i] - center[i]) * (pi[i] - center[i]);
+        }
+        return 0.5 * u * norm2;
+    };
+
+    std::vector<double> lambda(numCuts, 1.0 / static_cast<double>(numCuts));
+    if (warmWeights.size() == numCuts) {
+        lambda = warmWeights;
+        projectSimplex(lambda);
+    }
+    std::vector<double> previous(lambda);
+    std::vector<double> extrapolated(lambda);
+    double momentum = 1.0;
+
+    iterations_ = 0;
+    for (; iterations_ < maxIterations; ++iterations_) {
+        // Duality gap at the current weights: dual phi(lambda) vs. primal value of pi(lambda)
+        computePi(lambda);
+        evaluateCuts();
+        double dualValue = 0.0;
+        for (size_t k = 0; k < numCuts; ++k) {
+            dualValue += lambda[k] * cutValues[k];
+        }
+        const double penalty = proximal();
+        dualValue -= penalty;
+        const double primalValue = *std::min_element(cutValues.begin(), cutValues.end()) - penalty;
+        if (dualValue - primalValue <= tolerance * (1.0 + std::fabs(primalValue))) {
+            break;
+        }
+
+        // FISTA step on phi(lambda) = sum lambda_k alpha_k + max_pi [d . pi - u/2 ||pi - c||^2]
+        computePi(extrapolated);
+        evaluateCuts();
+        previous.swap(lambda);
+        for (size_t k = 0; k < numCuts; ++k) {
+            lambda[k] = extrapolated[k] - step * cutValues[k];
+        }
+        projectSimplex(lambda);
+
+        const double nextMomentum = 0.5 * (1.0 + std::sqrt(1.0 + 4.0 * momentum * momentum));
+        const double beta = (momentum - 1.0) / nextMomentum;
+        for (size_t k = 0; k < numCuts; ++k) {
+            extrapolated[k] = lambda[k] + beta * (lambda[k] - previous[k]);
+        }
+        momentum = nextMomentum;
+    }
+
+    computePi(lambda);
+    evaluateCuts();
+    weights_ = lambda;
+    pi_ = pi;
+    modelValue_ = *std::min_element(cutValues.begin(), cutValues.end());
+}
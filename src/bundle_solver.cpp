@@ -0,0 +1,175 @@
+#include "../include/bundle_solver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+BundleSolver::BundleSolver(ScipSolver& solver,
+                           const std::vector<ScipConstraint*>& rows,
+                           const std::vector<ScipVariable*>& columns,
+                           const BundleParams& params)
+    : relaxation_(solver, rows, columns), params_(params) {
+    if (params_.maxBundleSize < 2) {
+        throw std::runtime_error("Bundle must hold at least two cuts");
+    }
+}
+
+void BundleSolver::addCut(const std::vector<double>& pi, double value,
+                          const std::vector<double>& g, const std::vector<double>& x) {
+    // Linearization at pi: value + g . (p - pi) = (value - g . pi) + g . p
+    double alpha = value;
+    for (size_t i = 0; i < pi.size(); ++i) {
+        alpha -= g[i] * pi[i];
+    }
+    bundle_.push_back(Cut{g, alpha, x, 0});
+}
+
+void BundleSolver::compressBundle(const std::vector<double>& weights,
+                                  std::vector<double>& keptWeights) {
+    // 1. Age cuts and drop those inactive for too long
+    std::vector<Cut> kept;
+    keptWeights.clear();
+    for (size_t k = 0; k < bundle_.size(); ++k) {
+        Cut& cut = bundle_[k];
+        cut.inactiveAge = (weights[k] > 0.0) ? 0 : cut.inactiveAge + 1;
+        if (cut.inactiveAge <= params_.maxInactiveAge) {
+            keptWeights.push_back(weights[k]);
+            kept.push_back(std::move(cut));
+        }
+    }
+
+    // 2. Still too large (one slot is needed for the next cut): fold everything into
+    //    the aggregate cut sum_k w_k cut_k, which keeps the method convergent
+    if (static_cast<int>(kept.size()) >= params_.maxBundleSize) {
+        Cut aggregate{std::vector<double>(kept[0].subgradient.size(), 0.0), 0.0,
+                      std::vector<double>(kept[0].primal.size(), 0.0), 0};
+        double total = 0.0;
+        for (size_t k = 0; k < kept.size(); ++k) {
+            const double w = keptWeights[k];
+            if (w == 0.0) {
+                continue;
+            }
+            total += w;
+            aggregate.alpha += w * kept[k].alpha;
+            for (size_t i = 0; i < aggregate.subgradient.size(); ++i) {
+                aggregate.subgradient[i] += w * kept[k].subgradient[i];
+            }
+            for (size_t j = 0; j < aggregate.primal.size(); ++j) {
+                aggregate.primal[j] += w * kept[k].primal[j];
+            }
+        }
+        if (total <= 0.0) {
+            throw std::runtime_error("Bundle aggregation without positive weights");
+        }
+        for (double& value : aggregate.subgradient) {
+            value /= total;
+        }
+        for (double& value : aggregate.primal) {
+            value /= total;
+        }
+        aggregate.alpha /= total;
+        kept.clear();
+        kept.push_back(std::move(aggregate));
+        keptWeights.assign(1, 1.0);
+    }
+    bundle_.swap(kept);
+}
+
+LagrangianSolution BundleSolver::solve(const std::vector<double>& initialDuals) {
+    const int numRows = relaxation_.getNumRows();
+    const double sense = relaxation_.getSense();
+
+    std::vector<double> lower;
+    std::vector<double> upper;
+    relaxation_.dualBounds(lower, upper);
+
+    // 1. Stability center and its cut
+    std::vector<double> center = initialDuals.empty()
+        ? std::vector<double>(numRows, 0.0)
+        : relaxation_.fromModelSense(initialDuals);
+    relaxation_.projectDuals(center);
+
+    std::vector<double> x;
+    std::vector<double> g;
+    double centerValue = relaxation_.evaluate(center, x);
+    relaxation_.subgradient(center, x, g);
+
+    bundle_.clear();
+    addCut(center, centerValue, g, x);
+
+    double u = params_.proximalWeight;
+    std::vector<std::vector<double>> cuts;
+    std::vector<double> alphas;
+    std::vector<double> warmWeights(1, 1.0);
+
+    LagrangianSolution result;
+    std::vector<double> primal = x;
+    for (result.iterations = 0; result.iterations < params_.maxIterations; ++result.iterations) {
+        // 2. Stabilized master: maximize the cutting-plane model around the center
+        cuts.clear();
+        alphas.clear();
+        for (const Cut& cut : bundle_) {
+            cuts.push_back(cut.subgradient);
+            alphas.push_back(cut.alpha);
+        }
+        qp_.solve(cuts, alphas, center, lower, upper, u, warmWeights);
+        const std::vector<double>& weights = qp_.getWeights();
+
+        // Primal estimate: convex combination of the minimizers behind the cuts
+        std::fill(primal.begin(), primal.end(), 0.0);
+        for (size_t k = 0; k < bundle_.size(); ++k) {
+            for (size_t j = 0; j < primal.size(); ++j) {
+                primal[j] += weights[k] * bundle_[k].primal[j];
+            }
+        }
+
+        // Stop only when the model predicts no ascent and the aggregate subgradient is
+        // small; a large proximal weight alone can make the prediction look tiny
+        double aggregateNorm = 0.0;
+        for (int i = 0; i < numRows; ++i) {
+            double component = 0.0;
+            for (size_t k = 0; k < bundle_.size(); ++k) {
+                component += weights[k] * bundle_[k].subgradient[i];
+            }
+            if ((component < 0.0 && center[i] > lower[i]) || (component > 0.0 && center[i] < upper[i])) {
+                aggregateNorm = std::max(aggregateNorm, std::fabs(component));
+            }
+        }
+        const double predicted = qp_.getModelValue() - centerValue;
+        if (predicted <= params_.tolerance * (1.0 + std::fabs(centerValue))
+            && aggregateNorm <= params_.subgradientTolerance) {
+            result.converged = true;
+            break;
+        }
+
+        // 3. Oracle call at the candidate
+        const std::vector<double> candidate = qp_.getPi();
+        const double candidateValue = relaxation_.evaluate(candidate, x);
+        relaxation_.subgradient(candidate, x, g);
+
+        // 4. Bundle management before the new cut goes in
+        compressBundle(weights, warmWeights);
+        addCut(candidate, candidateValue, g, x);
+        warmWeights.push_back(0.0);
+
+        // 5. Serious step moves the center, null step only enriches the model
+        const double achieved = candidateValue - centerValue;
+        if (achieved >= params_.seriousStepFraction * predicted) {
+            center = candidate;
+            centerValue = candidateValue;
+            if (achieved >= 0.5 * predicted) {
+                u = std::max(params_.minProximalWeight, 0.5 * u);
+            }
+        } else if (achieved < 0.0) {
+            u = std::min(params_.maxProximalWeight, 1.1 * u);
+        }
+    }
+
+    // 6. Report in the model's objective sense
+    relaxation_.toModelSense(center);
+    result.duals = std::move(center);
+    result.primal = std::move(primal);
+    result.dualBound = sense * centerValue;
+    result.primalObjective = relaxation_.primalObjective(result.primal);
+    result.maxViolation = relaxation_.maxViolation(result.primal);
+    return result;
+}
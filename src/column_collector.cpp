@@ -0,0 +1,94 @@
+#include "../include/column_collector.hpp"
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+TopKColumnCollector::TopKColumnCollector(size_t capacity, double tolerance)
+    : capacity_(capacity), tolerance_(tolerance), threshold_(-tolerance), offered_(0),
+      accepted_(0) {
+    if (capacity == 0) {
+        throw std::runtime_error("Column collector needs a positive capacity");
+    }
+}
+
+std::string TopKColumnCollector::key(const Column& column) {
+    std::string key(sizeof(int) * column.rows.size() + sizeof(double) * column.values.size(), '\0');
+    char* out = &key[0];
+    std::memcpy(out, column.rows.data(), sizeof(int) * column.rows.size());
+    out += sizeof(int) * column.rows.size();
+    std::memcpy(out, column.values.data(), sizeof(double) * column.values.size());
+    return key;
+}
+
+void TopKColumnCollector::updateThreshold() {
+    threshold_.store(order_.size() < capacity_ ? -tolerance_ : order_.rbegin()->first,
+                     std::memory_order_relaxed);
+}
+
+bool TopKColumnCollector::offer(Column&& column) {
+    offered_.fetch_add(1, std::memory_order_relaxed);
+    if (!accepts(column.reducedCost)) {
+        return false;
+    }
+    std::string columnKey = key(column);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (column.reducedCost >= threshold_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    // Same coefficients: keep the cheaper one
+    auto known = keys_.find(columnKey);
+    if (known != keys_.end()) {
+        const size_t slot = known->second;
+        if (slots_[slot].reducedCost <= column.reducedCost) {
+            return false;
+        }
+        order_.erase({slots_[slot].reducedCost, slot});
+        order_.emplace(column.reducedCost, slot);
+        slots_[slot] = std::move(column);
+        updateThreshold();
+        accepted_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Full: evict the worst
+    if (order_.size() == capacity_) {
+        const size_t worst = order_.rbegin()->second;
+        order_.erase(std::prev(order_.end()));
+        keys_.erase(key(slots_[worst]));
+        freeSlots_.push_back(worst);
+    }
+    size_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        slots_[slot] = std::move(column);
+    } else {
+        slot = slots_.size();
+        slots_.push_back(std::move(column));
+    }
+    order_.emplace(slots_[slot].reducedCost, slot);
+    keys_.emplace(std::move(columnKey), slot);
+    updateThreshold();
+    accepted_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t TopKColumnCollector::drain(std::vector<Column>& columns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t drained = order_.size();
+    for (const auto& entry : order_) {
+        columns.push_back(std::move(slots_[entry.second]));
+    }
+    slots_.clear();
+    freeSlots_.clear();
+    order_.clear();
+    keys_.clear();
+    updateThreshold();
+    return drained;
+}
+
+size_t TopKColumnCollector::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return order_.size();
+}
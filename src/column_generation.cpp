@@ -0,0 +1,386 @@
+#include "../include/column_generation.hpp"
+#include "../include/column_queue.hpp"
+#include "../include/run_log.hpp"
+#include "../include/solver_metrics.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Slots of ColumnGeneration::metricIds_
+enum LoopMetric {
+    kIterations = 0,
+    kColumnsAdded,
+    kColumnsDrained,
+    kMasterColumns,
+    kMasterObjective,
+    kLagrangianBound,
+    kGap,
+    kMasterSeconds,
+    kNumLoopMetrics
+};
+
+// Exact bytes of cost, rows and coefficients; equal keys are the same master column
+std::string columnKey(const Column& column) {
+    std::string key(reinterpret_cast<const char*>(&column.cost), sizeof(double));
+    key.append(reinterpret_cast<const char*>(column.rows.data()), column.rows.size() * sizeof(int));
+    key.append(reinterpret_cast<const char*>(column.values.data()), column.values.size() * sizeof(double));
+    return key;
+}
+
+// Prometheus label value: quotes and backslashes escaped
+std::string labelValue(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c == '\n' ? ' ' : c;
+    }
+    return escaped;
+}
+
+} // namespace
+
+ColumnGeneration::ColumnGeneration(ScipSolver& master, const std::vector<ScipConstraint*>& rows)
+    : master_(master), rows_(rows), queue_(nullptr), log_(nullptr), metrics_(nullptr), lastBound_(-std::numeric_limits<double>::infinity()) {
+    if (rows_.empty()) {
+        throw std::runtime_error("Column generation master needs at least one row");
+    }
+    for (const auto* row : rows_) {
+        if (row == nullptr) {
+            throw std::runtime_error("Null constraint pointer in column generation master");
+        }
+    }
+}
+
+void ColumnGeneration::addOracle(PricingOracle* oracle) {
+    if (oracle == nullptr) {
+        throw std::runtime_error("Cannot add null pricing oracle");
+    }
+    oracles_.push_back(oracle);
+    if (metrics_ != nullptr) {
+        registerOracleMetrics(oracle);
+    }
+}
+
+void ColumnGeneration::setMetrics(SolverMetrics* metrics, const std::string& labels) {
+    metrics_ = metrics;
+    metricLabels_ = labels;
+    metricIds_.clear();
+    oracleMetricIds_.clear();
+    if (metrics_ == nullptr) {
+        return;
+    }
+    registerMetrics();
+    for (const PricingOracle* oracle : oracles_) {
+        registerOracleMetrics(oracle);
+    }
+}
+
+ScipVariable& ColumnGeneration::addColumn(const Column& column) {
+    if (column.rows.size() != column.values.size()) {
+        throw std::runtime_error("Column rows and values size mismatch");
+    }
+    for (int row : column.rows) {
+        if (row < 0 || row >= static_cast<int>(rows_.size())) {
+            throw std::runtime_error("Column references unknown master row " + std::to_string(row));
+        }
+    }
+
+    // Already in the master, possibly with a bound lowered by reduced-cost fixing
+    const int existing = findColumn(column);
+    if (existing >= 0) {
+        return columns_[existing];
+    }
+
+    // Back to the problem stage if the master was solved
+    master_.freeTransform();
+
+    SCIP* scip = master_.get();
+    const std::string name = column.name.empty()
+        ? "col_" + std::to_string(columns_.size())
+        : column.name;
+    const double ub = std::isinf(column.upperBound) ? SCIPinfinity(scip) : column.upperBound;
+
+    columns_.push_back(master_.createVariable(name, 0.0, ub, column.cost));
+    ScipVariable& var = columns_.back();
+    for (size_t k = 0; k < column.rows.size(); ++k) {
+        rows_[column.rows[k]]->addVariable(&var, column.values[k]);
+    }
+    columnData_.push_back(column);
+    columnIndex_.emplace(columnKey(column), static_cast<int>(columns_.size()) - 1);
+    return var;
+}
+
+int ColumnGeneration::findColumn(const Column& column) const {
+    auto found = columnIndex_.find(columnKey(column));
+    return found == columnIndex_.end() ? -1 : found->second;
+}
+
+void ColumnGeneration::registerMetrics() {
+    const std::string& labels = metricLabels_;
+    metricIds_.assign(kNumLoopMetrics, -1);
+    metricIds_[kIterations] = metrics_->addCounter(
+        "cg_iterations_total", "Column generation iterations", labels);
+    metricIds_[kColumnsAdded] = metrics_->addCounter(
+        "cg_columns_added_total", "Columns added to the master", labels);
+    metricIds_[kColumnsDrained] = metrics_->addCounter(
+        "cg_columns_drained_total", "Columns taken from the concurrent column queue", labels);
+    metricIds_[kMasterColumns] = metrics_->addGauge(
+        "cg_master_columns", "Columns in the restricted master", labels);
+    metricIds_[kMasterObjective] = metrics_->addGauge(
+        "cg_master_objective", "Last restricted master LP value", labels);
+    metricIds_[kLagrangianBound] = metrics_->addGauge(
+        "cg_lagrangian_bound", "Best Lagrangian lower bound", labels);
+    metricIds_[kGap] = metrics_->addGauge(
+        "cg_gap", "Relative gap of the incumbent (else the master value) to the bound", labels);
+    metricIds_[kMasterSeconds] = metrics_->addCounter(
+        "cg_master_seconds_total", "Seconds spent in master solves", labels);
+}
+
+void ColumnGeneration::registerOracleMetrics(const PricingOracle* oracle) {
+    const std::string labels = (metricLabels_.empty() ? "" : metricLabels_ + ",")
+                               + "oracle=\"" + labelValue(oracle->getName()) + "\"";
+    oracleMetricIds_.push_back(metrics_->addCounter(
+        "cg_pricing_seconds_total", "Seconds spent in pricing per oracle", labels));
+    oracleMetricIds_.push_back(metrics_->addCounter(
+        "cg_pricing_calls_total", "Pricing calls per oracle", labels));
+}
+
+ColumnGenerationStats ColumnGeneration::run(const ColumnGenerationParams& params) {
+    ColumnGenerationStats stats;
+    stats.lagrangianBound = -std::numeric_limits<double>::infinity();
+
+    std::vector<Column> candidates;
+    const auto runStart = std::chrono::steady_clock::now();
+    for (stats.iterations = 0; stats.iterations < params.maxIterations; ++stats.iterations) {
+        if (secondsSince(runStart) > params.timeLimit) {
+            break;
+        }
+
+        // 1. Restricted master LP, limited to the time left of the run
+        if (std::isfinite(params.timeLimit)) {
+            master_.setTimeLimit(std::max(params.timeLimit - secondsSince(runStart), 1e-3));
+        }
+        auto start = std::chrono::steady_clock::now();
+        master_.solve();
+        const double masterSeconds = secondsSince(start);
+        stats.masterTime += masterSeconds;
+        if (master_.getStatus() == SCIP_STATUS_TIMELIMIT) {
+            break;          // Keep the values of the last completed iteration
+        }
+        if (master_.getStatus() != SCIP_STATUS_OPTIMAL) {
+            throw std::runtime_error("Restricted master not solved to optimality (status "
+                                     + std::to_string(master_.getStatus()) + ")");
+        }
+        stats.masterObjective = master_.getObjectiveValue();
+        duals_ = master_.getDualValues(rows_);
+        if (metrics_ != nullptr) {
+            metrics_->add(metricIds_[kMasterSeconds], masterSeconds);
+            metrics_->set(metricIds_[kMasterObjective], stats.masterObjective);
+        }
+
+        // 2. Pricing
+        start = std::chrono::steady_clock::now();
+        candidates.clear();
+        double bound = stats.masterObjective;
+        for (size_t k = 0; k < oracles_.size(); ++k) {
+            PricingOracle* oracle = oracles_[k];
+            const auto oracleStart = std::chrono::steady_clock::now();
+            const double minReducedCost = oracle->price(duals_, candidates);
+            if (metrics_ != nullptr) {
+                metrics_->add(oracleMetricIds_[2 * k], secondsSince(oracleStart));
+                metrics_->add(oracleMetricIds_[2 * k + 1], 1.0);
+            }
+            if (minReducedCost < -params.reducedCostTolerance) {
+                bound += oracle->getMultiplicity() * minReducedCost;
+            }
+        }
+        const size_t fromOracles = candidates.size();
+        size_t drained = 0;
+        if (queue_ != nullptr) {
+            // Columns carried over from earlier rounds compete again at the new duals
+            const size_t room = queue_->capacity() - std::min(queue_->capacity(), queueCarryOver_.size());
+            drained = queue_->drain(queueCarryOver_, room);
+            stats.columnsDrained += static_cast<int>(drained);
+            for (Column& column : queueCarryOver_) {
+                column.reducedCost = column.cost;
+                for (size_t k = 0; k < column.rows.size(); ++k) {
+                    column.reducedCost -= duals_.at(column.rows[k]) * column.values[k];
+                }
+                candidates.push_back(std::move(column));
+            }
+            queueCarryOver_.clear();
+        }
+        stats.pricingTime += secondsSince(start);
+        lastBound_ = std::isnan(bound) ? -std::numeric_limits<double>::infinity() : bound;
+        stats.lagrangianBound = std::max(stats.lagrangianBound, lastBound_);
+        if (metrics_ != nullptr) {
+            const double reference = std::isfinite(params.incumbentValue)
+                ? params.incumbentValue : stats.masterObjective;
+            metrics_->add(metricIds_[kColumnsDrained], static_cast<double>(drained));
+            metrics_->set(metricIds_[kLagrangianBound], stats.lagrangianBound);
+            metrics_->set(metricIds_[kGap], (reference - stats.lagrangianBound)
+                                            / std::max(1.0, std::abs(reference)));
+        }
+
+        // 3. Keep the most negative reduced costs of columns not in the master yet (a
+        // master column prices out only when fixing lowered its bound)
+        std::vector<size_t> order;
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            if (findColumn(candidates[c]) < 0) {
+                order.push_back(c);
+            }
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return candidates[a].reducedCost < candidates[b].reducedCost;
+        });
+        size_t selected = 0;
+        while (selected < order.size() && static_cast<int>(selected) < params.maxColumnsPerIteration
+               && candidates[order[selected]].reducedCost < -params.reducedCostTolerance) {
+            ++selected;
+        }
+        // Queue columns that missed the cut wait for the next round; the carry-over is
+        // capped so the queue keeps draining and producers are not blocked for good
+        if (queue_ != nullptr) {
+            const size_t keep = queue_->capacity() / 2;
+            for (size_t k = selected; k < order.size() && queueCarryOver_.size() < keep; ++k) {
+                if (order[k] >= fromOracles) {
+                    queueCarryOver_.push_back(std::move(candidates[order[k]]));
+                }
+            }
+        }
+        std::vector<Column> chosen;
+        chosen.reserve(selected);
+        for (size_t k = 0; k < selected; ++k) {
+            chosen.push_back(std::move(candidates[order[k]]));
+        }
+        candidates.swap(chosen);
+
+        if (log_ != nullptr) {
+            RunLogRecord record;
+            record.iteration = stats.iterations;
+            record.columnsAdded = static_cast<int32_t>(candidates.size());
+            record.columns = static_cast<int32_t>(columns_.size() + candidates.size());
+            record.objective = stats.masterObjective;
+            record.bound = stats.lagrangianBound;
+            record.masterSeconds = stats.masterTime;
+            record.pricingSeconds = stats.pricingTime;
+            log_->write(record);
+        }
+        if (metrics_ != nullptr) {
+            metrics_->add(metricIds_[kIterations], 1.0);
+            metrics_->add(metricIds_[kColumnsAdded], static_cast<double>(candidates.size()));
+            metrics_->set(metricIds_[kMasterColumns], static_cast<double>(columns_.size() + candidates.size()));
+        }
+        if (params.verbose) {
+            std::cout << "CG iter " << stats.iterations
+                      << "  master " << stats.masterObjective
+                      << "  bound " << stats.lagrangianBound
+                      << "  new columns " << candidates.size()
+                      << "  total " << columns_.size() << std::endl;
+        }
+
+        // Shrink the master as the gap closes; the last round has the tightest bound
+        int fixed = 0;
+        if (std::isfinite(params.incumbentValue)) {
+            fixed = static_cast<int>(fixColumnsByReducedCost(params.incumbentValue).size());
+            stats.columnsFixed += fixed;
+        }
+
+        if (candidates.empty()) {
+            stats.optimal = true;
+            if (fixed > 0) {
+                // Fixing freed the transformed problem; fixed columns sit at zero in the
+                // LP optimum, so the re-solve only restores the solution values. Pricing
+                // may have used up the run's time, so the restore runs without a limit.
+                master_.setTimeLimit(std::numeric_limits<double>::infinity());
+                master_.solve();
+                stats.optimal = master_.getStatus() == SCIP_STATUS_OPTIMAL;
+            }
+            break;
+        }
+        for (const Column& column : candidates) {
+            addColumn(column);
+        }
+        stats.columnsAdded += static_cast<int>(candidates.size());
+    }
+    if (log_ != nullptr) {
+        RunLogRecord record;
+        record.event = RunLogEvent::Finished;
+        record.iteration = stats.iterations;
+        record.columnsAdded = stats.columnsAdded;
+        record.columns = static_cast<int32_t>(columns_.size());
+        record.optimal = stats.optimal ? 1 : 0;
+        record.objective = stats.masterObjective;
+        record.bound = stats.lagrangianBound;
+        record.masterSeconds = stats.masterTime;
+        record.pricingSeconds = stats.pricingTime;
+        log_->write(record);
+    }
+    if (std::isfinite(params.timeLimit)) {
+        master_.setTimeLimit(std::numeric_limits<double>::infinity());
+    }
+    return stats;
+}
+
+std::vector<ColumnBoundChange> ColumnGeneration::fixColumnsByReducedCost(double incumbent,
+                                                                         bool integral) {
+    std::vector<ColumnBoundChange> changes;
+    if (!std::isfinite(lastBound_) || !std::isfinite(incumbent) || duals_.size() != rows_.size()) {
+        return changes;
+    }
+    const double gap = incumbent - lastBound_;
+    if (gap < 0.0) {
+        return changes;
+    }
+
+    bool transformed = false;
+    for (size_t j = 0; j < columns_.size(); ++j) {
+        const Column& column = columnData_[j];
+        double reducedCost = column.cost;
+        for (size_t k = 0; k < column.rows.size(); ++k) {
+            reducedCost -= duals_[column.rows[k]] * column.values[k];
+        }
+        if (reducedCost <= 1e-9) {
+            continue;
+        }
+
+        ScipVariable& var = columns_[j];
+        const double oldUb = var.getUpperBound();
+        double newUb = gap / reducedCost;
+        if (integral) {
+            newUb = std::floor(newUb + 1e-9);
+        }
+        if (newUb >= oldUb - 1e-9 || newUb < var.getLowerBound()) {
+            continue;
+        }
+        if (!transformed) {
+            master_.freeTransform();
+            transformed = true;
+        }
+        var.setBounds(var.getLowerBound(), newUb);
+        changes.push_back({static_cast<int>(j), oldUb});
+    }
+    return changes;
+}
+
+void ColumnGeneration::restoreColumnBounds(const std::vector<ColumnBoundChange>& changes) {
+    if (changes.empty()) {
+        return;
+    }
+    master_.freeTransform();
+    for (auto it = changes.rbegin(); it != changes.rend(); ++it) {
+        ScipVariable& var = columns_.at(it->column);
+        var.setBounds(var.getLowerBound(), it->oldUpperBound);
+    }
+}
@@ -0,0 +1,460 @@
+#include "../include/column_lns.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include "../include/column_queue.hpp"
+#include "../include/solution_pool.hpp"
+
+namespace {
+
+// Dual given to fixed rows so that columns touching them price out
+const double kFixedRowDual = -1e9;
+
+// Pool segments before they are merged into one (bounds the snapshot copy)
+const size_t kMaxPoolSegments = 64;
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Identity of a column for the pool: cost, rows and coefficients
+std::string columnKey(const Column& column) {
+    std::string key(sizeof(double) * (1 + column.values.size())
+                    + sizeof(int) * column.rows.size(), '\0');
+    char* out = &key[0];
+    std::memcpy(out, &column.cost, sizeof(double));
+    out += sizeof(double);
+    std::memcpy(out, column.rows.data(), sizeof(int) * column.rows.size());
+    out += sizeof(int) * column.rows.size();
+    std::memcpy(out, column.values.data(), sizeof(double) * column.values.size());
+    return key;
+}
+
+// The caller's oracle seen from a sub-master over the freed rows: duals are expanded to
+// the full row set, columns touching fixed rows are dropped and the rest renumbered
+class RestrictedOracle : public PricingOracle {
+private:
+    PricingOracle& inner_;
+    const std::vector<int>& fullToSub_;         // -1 for fixed rows
+    const std::vector<int>& subToFull_;
+    std::vector<double> fullDuals_;
+    std::vector<Column> buffer_;
+
+public:
+    RestrictedOracle(PricingOracle& inner, const std::vector<int>& fullToSub,
+                     const std::vector<int>& subToFull)
+        : inner_(inner), fullToSub_(fullToSub), subToFull_(subToFull),
+          fullDuals_(fullToSub.size(), kFixedRowDual) {}
+
+    std::string getName() const override { return "lns_" + inner_.getName(); }
+
+    double price(const std::vector<double>& duals, std::vector<Column>& columns) override {
+        for (size_t i = 0; i < subToFull_.size(); ++i) {
+            fullDuals_[subToFull_[i]] = duals[i];
+        }
+        buffer_.clear();
+        inner_.price(fullDuals_, buffer_);
+        for (Column& column : buffer_) {
+            bool inside = true;
+            for (int& row : column.rows) {
+                row = fullToSub_[row];
+                inside = inside && row >= 0;
+            }
+            if (inside) {
+                columns.push_back(std::move(column));
+            }
+        }
+        // The penalized duals make the inner bound meaningless for the sub-master
+        return -std::numeric_limits<double>::infinity();
+    }
+};
+
+} // namespace
+
+ColumnLns::ColumnLns(ColumnGeneration& cg,
+                     std::function<std::unique_ptr<PricingOracle>()> oracleFactory,
+                     TaskScheduler& scheduler, const LnsParams& params)
+    : numRows_(static_cast<int>(cg.getRows().size())), oracleFactory_(std::move(oracleFactory)),
+      params_(params), queue_(nullptr), scheduler_(scheduler),
+      cutoff_(std::numeric_limits<double>::infinity()), running_(false), stop_(false) {
+    if (params_.concurrentMoves < 1) {
+        params_.concurrentMoves = 1;
+    }
+    params_.destroyFraction = std::min(1.0, std::max(0.0, params_.destroyFraction));
+
+    SCIP* scip = cg.getMaster().get();
+    const double inf = SCIPinfinity(scip);
+    for (ScipConstraint* row : cg.getRows()) {
+        const double lhs = row->getLhs();
+        const double rhs = row->getRhs();
+        lhs_.push_back(lhs <= -inf ? -std::numeric_limits<double>::infinity() : lhs);
+        rhs_.push_back(rhs >= inf ? std::numeric_limits<double>::infinity() : rhs);
+    }
+    std::vector<Column> columns;
+    for (int j = 0; j < cg.getNumColumns(); ++j) {
+        columns.push_back(cg.getColumnData(j));
+    }
+    addToPool(columns);
+    rowDistance_ = [](int a, int b) { return std::abs(static_cast<double>(a - b)); };
+}
+
+ColumnLns::~ColumnLns() {
+    stop();
+}
+
+std::shared_ptr<const std::vector<Column>> ColumnLns::addToPool(const std::vector<Column>& columns) {
+    auto segment = std::make_shared<std::vector<Column>>();
+    for (const Column& column : columns) {
+        if (poolKeys_.insert(columnKey(column)).second) {
+            segment->push_back(column);
+            segment->back().name.clear();
+            segment->back().reducedCost = 0.0;
+        }
+    }
+    if (segment->empty()) {
+        return nullptr;
+    }
+    pool_.push_back(segment);
+    if (pool_.size() > kMaxPoolSegments) {
+        // Snapshots held by running moves keep the old segments alive
+        auto merged = std::make_shared<std::vector<Column>>();
+        merged->reserve(poolKeys_.size());
+        for (const auto& part : pool_) {
+            merged->insert(merged->end(), part->begin(), part->end());
+        }
+        pool_.assign(1, std::move(merged));
+    }
+    return segment;
+}
+
+void ColumnLns::offerColumns(const std::vector<Column>& columns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    addToPool(columns);
+}
+
+void ColumnLns::offerIncumbent(const std::vector<Column>& columns, const std::vector<double>& values) {
+    if (columns.size() != values.size()) {
+        throw std::runtime_error("One value per incumbent column expected");
+    }
+    LnsSolution solution;
+    solution.objective = 0.0;
+    for (size_t j = 0; j < columns.size(); ++j) {
+        if (values[j] > 1e-9) {
+            solution.columns.push_back(columns[j]);
+            solution.values.push_back(values[j]);
+            solution.objective += columns[j].cost * values[j];
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    addToPool(solution.columns);
+    cutoff_ = std::min(cutoff_, solution.objective);
+    if (solution.objective < best_.objective) {
+        best_ = std::move(solution);
+        stats_.bestObjective = best_.objective;
+        submitWaiting();
+    }
+}
+
+void ColumnLns::offerIncumbent(const ColumnGeneration& cg, const ScipSolution& solution) {
+    std::vector<Column> columns;
+    double objective = 0.0;
+    for (size_t k = 0; k < solution.indices.size(); ++k) {
+        columns.push_back(cg.getColumnData(solution.indices[k]));
+        objective += columns.back().cost * solution.values[k];
+    }
+    if (std::abs(objective - solution.objective) > 1e-6 * std::max(1.0, std::abs(solution.objective))) {
+        offerCutoff(solution.objective);
+        return;
+    }
+    offerIncumbent(columns, solution.values);
+}
+
+void ColumnLns::offerCutoff(double objective) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cutoff_ = std::min(cutoff_, objective);
+}
+
+std::vector<ScipVariable*> ColumnLns::getColumnVariables(ColumnGeneration& cg) {
+    std::vector<ScipVariable*> variables;
+    for (int j = 0; j < cg.getNumColumns(); ++j) {
+        variables.push_back(&cg.getColumn(j));
+    }
+    return variables;
+}
+
+void ColumnLns::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    stop_.store(false);
+    chains_.clear();
+    chains_.resize(params_.concurrentMoves);
+    for (size_t c = 0; c < chains_.size(); ++c) {
+        chains_[c].rng.seed(params_.seed + 7919u * static_cast<unsigned>(c));
+        if (oracleFactory_) {
+            try {
+                chains_[c].oracle = oracleFactory_();
+            } catch (const std::exception&) {
+                chains_[c].oracle.reset();      // Moves then search the pool only
+            }
+        }
+    }
+    submitWaiting();
+}
+
+void ColumnLns::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        stop_.store(true);
+    }
+    scheduler_.wait(group_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    chains_.clear();
+    running_ = false;
+}
+
+LnsSolution ColumnLns::getBest() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return best_;
+}
+
+LnsStats ColumnLns::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void ColumnLns::submitWaiting() {
+    if (!running_ || stop_.load() || best_.columns.empty()) {
+        return;
+    }
+    for (size_t c = 0; c < chains_.size(); ++c) {
+        if (chains_[c].waiting) {
+            chains_[c].waiting = false;
+            scheduler_.submit(group_, [this, c] { runMove(c); }, TaskPriority::Low);
+        }
+    }
+}
+
+void ColumnLns::runMove(size_t chain) {
+    Chain& state = chains_[chain];
+    if (stop_.load()) {
+        return;
+    }
+    try {
+        move(state.oracle.get(), state.rng);
+    } catch (const std::exception&) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.failedMoves;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (params_.maxMoves <= 0 || ++state.moves < params_.maxMoves) {
+        state.waiting = true;
+        submitWaiting();
+    }
+}
+
+bool ColumnLns::move(PricingOracle* oracle, std::mt19937& rng) {
+    const auto start = std::chrono::steady_clock::now();
+    LnsSolution incumbent;
+    std::vector<std::shared_ptr<const std::vector<Column>>> pool;
+    double cutoff;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        incumbent = best_;
+        pool = pool_;
+        cutoff = cutoff_;
+        ++stats_.moves;
+    }
+    const size_t numColumns = incumbent.columns.size();
+
+    // Destroy: the columns closest to a random seed column
+    const size_t seed = std::uniform_int_distribution<size_t>(0, numColumns - 1)(rng);
+    const std::vector<int>& seedRows = incumbent.columns[seed].rows;
+    std::vector<std::pair<double, size_t>> distance(numColumns);
+    for (size_t j = 0; j < numColumns; ++j) {
+        double closest = j == seed ? -1.0 : std::numeric_limits<double>::infinity();
+        for (int row : incumbent.columns[j].rows) {
+            for (int seedRow : seedRows) {
+                closest = std::min(closest, rowDistance_(row, seedRow));
+            }
+        }
+        distance[j] = {closest, j};
+    }
+    std::shuffle(distance.begin(), distance.end(), rng);      // Random ties
+    const size_t destroyed = std::max<size_t>(
+        1, static_cast<size_t>(std::lround(params_.destroyFraction * numColumns)));
+    std::partial_sort(distance.begin(), distance.begin() + destroyed, distance.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<char> freedColumn(numColumns, 0);
+    for (size_t k = 0; k < destroyed; ++k) {
+        freedColumn[distance[k].second] = 1;
+    }
+
+    // Freed rows and the activity the fixed columns leave on them
+    std::vector<int> fullToSub(numRows_, -1);
+    std::vector<int> subToFull;
+    std::vector<double> fixedActivity(numRows_, 0.0);
+    double fixedCost = 0.0;
+    for (size_t j = 0; j < numColumns; ++j) {
+        const Column& column = incumbent.columns[j];
+        if (freedColumn[j]) {
+            for (int row : column.rows) {
+                if (fullToSub[row] < 0) {
+                    fullToSub[row] = static_cast<int>(subToFull.size());
+                    subToFull.push_back(row);
+                }
+            }
+        } else {
+            fixedCost += column.cost * incumbent.values[j];
+            for (size_t k = 0; k < column.rows.size(); ++k) {
+                fixedActivity[column.rows[k]] += column.values[k] * incumbent.values[j];
+            }
+        }
+    }
+
+    // Pool columns that live on freed rows only (includes the destroyed ones)
+    std::vector<Column> candidates;
+    for (const auto& segment : pool) {
+        for (const Column& column : *segment) {
+            bool inside = true;
+            for (int row : column.rows) {
+                inside = inside && fullToSub[row] >= 0;
+            }
+            if (inside) {
+                candidates.push_back(column);
+                for (int& row : candidates.back().rows) {
+                    row = fullToSub[row];
+                }
+            }
+        }
+    }
+
+    const int numSubRows = static_cast<int>(subToFull.size());
+    auto buildModel = [&](ScipSolver& solver, SCIP_VARTYPE type, std::deque<ScipVariable>& vars,
+                          std::deque<ScipConstraint>& rows) {
+        SCIP* scip = solver.get();
+        const double inf = SCIPinfinity(scip);
+        std::vector<std::vector<ScipVariable*>> terms(numSubRows);
+        std::vector<std::vector<double>> coefficients(numSubRows);
+        for (size_t j = 0; j < candidates.size(); ++j) {
+            const Column& column = candidates[j];
+            const double ub = std::isinf(column.upperBound) ? inf : column.upperBound;
+            vars.push_back(solver.createVariable("lns_" + std::to_string(j), 0.0, ub, column.cost,
+                                                 type));
+            for (size_t k = 0; k < column.rows.size(); ++k) {
+                terms[column.rows[k]].push_back(&vars.back());
+                coefficients[column.rows[k]].push_back(column.values[k]);
+            }
+        }
+        for (int i = 0; i < numSubRows; ++i) {
+            const int row = subToFull[i];
+            const double lhs = std::isinf(lhs_[row]) ? -inf : lhs_[row] - fixedActivity[row];
+            const double rhs = std::isinf(rhs_[row]) ? inf : rhs_[row] - fixedActivity[row];
+            rows.push_back(solver.createConstraint("lns_row_" + std::to_string(row), terms[i],
+                                                   coefficients[i], lhs, rhs));
+        }
+    };
+
+    // Repair 1: restricted column generation over the freed rows
+    if (oracle != nullptr && params_.maxPricingIterations > 0) {
+        ScipSolver lp("lns_lp");
+        lp.setColumnGenerationMode();
+        std::deque<ScipVariable> vars;
+        std::deque<ScipConstraint> rows;
+        buildModel(lp, SCIP_VARTYPE_CONTINUOUS, vars, rows);
+        std::vector<ScipConstraint*> rowPointers;
+        for (ScipConstraint& row : rows) {
+            rowPointers.push_back(&row);
+        }
+
+        RestrictedOracle restricted(*oracle, fullToSub, subToFull);
+        ColumnGeneration cg(lp, rowPointers);
+        cg.addOracle(&restricted);
+        ColumnGenerationParams cgParams;
+        cgParams.maxIterations = params_.maxPricingIterations;
+        cgParams.timeLimit = params_.moveTimeLimit / 2;
+        cg.run(cgParams);
+
+        std::vector<Column> priced;
+        for (int j = 0; j < cg.getNumColumns(); ++j) {
+            Column column = cg.getColumnData(j);
+            candidates.push_back(column);
+            for (int& row : column.rows) {
+                row = subToFull[row];
+            }
+            priced.push_back(std::move(column));
+        }
+        std::shared_ptr<const std::vector<Column>> added;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            added = addToPool(priced);
+            stats_.columnsPriced += added ? added->size() : 0;
+        }
+        if (added && queue_ != nullptr) {
+            for (const Column& column : *added) {
+                queue_->tryPush(column);
+            }
+        }
+    }
+
+    // Repair 2: sub-MIP over the candidates with the best known objective as cutoff
+    ScipSolver mip("lns_mip");
+    mip.setVerbosity(0);
+    std::deque<ScipVariable> vars;
+    std::deque<ScipConstraint> rows;
+    buildModel(mip, SCIP_VARTYPE_INTEGER, vars, rows);
+    if (std::isfinite(cutoff)) {
+        SCIP_CALL_EXCEPT( SCIPsetObjlimit(mip.get(), cutoff - fixedCost - params_.minImprovement) );
+    }
+    mip.setTimeLimit(std::max(0.1, params_.moveTimeLimit - secondsSince(start)));
+    mip.solve();
+    if (SCIPgetNSols(mip.get()) == 0) {
+        return false;
+    }
+
+    LnsSolution improved;
+    improved.objective = fixedCost;
+    for (size_t j = 0; j < numColumns; ++j) {
+        if (!freedColumn[j]) {
+            improved.columns.push_back(incumbent.columns[j]);
+            improved.values.push_back(incumbent.values[j]);
+        }
+    }
+    size_t j = 0;
+    for (ScipVariable& var : vars) {
+        const double value = std::round(var.getSolutionValue());
+        if (value > 0.0) {
+            Column column = candidates[j];
+            for (int& row : column.rows) {
+                row = subToFull[row];
+            }
+            improved.objective += column.cost * value;
+            improved.columns.push_back(std::move(column));
+            improved.values.push_back(value);
+        }
+        ++j;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (improved.objective > best_.objective - params_.minImprovement) {
+            return false;       // Another move or the main solve got there first
+        }
+        best_ = improved;
+        cutoff_ = std::min(cutoff_, improved.objective);
+        stats_.bestObjective = improved.objective;
+        ++stats_.improvements;
+    }
+    if (onImprovement_) {
+        onImprovement_(improved);
+    }
+    return true;
+}
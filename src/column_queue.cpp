@@ -0,0 +1,136 @@
+#include "../include/column_queue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+uint64_t roundUpToPowerOfTwo(size_t value) {
+    uint64_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+ColumnQueue::ColumnQueue(size_t capacity, int maxNonzeros)
+    : capacity_(roundUpToPowerOfTwo(capacity)), mask_(capacity_ - 1),
+      maxNonzeros_(maxNonzeros), slots_(new Slot[capacity_]),
+      rowSlab_(capacity_ * static_cast<size_t>(std::max(maxNonzeros, 0))),
+      valueSlab_(capacity_ * static_cast<size_t>(std::max(maxNonzeros, 0))),
+      enqueuePos_(0), dequeuePos_(0), closed_(false), pushed_(0), fullEvents_(0),
+      drained_(0) {
+    if (maxNonzeros <= 0) {
+        throw std::runtime_error("Column queue needs a positive nonzero limit per column");
+    }
+    for (uint64_t i = 0; i < capacity_; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ColumnQueue::tryPush(const Column& column) {
+    if (column.rows.size() != column.values.size()) {
+        throw std::runtime_error("Column rows and values size mismatch");
+    }
+    if (static_cast<int>(column.rows.size()) > maxNonzeros_) {
+        throw std::runtime_error("Column with " + std::to_string(column.rows.size())
+                                 + " nonzeros exceeds the queue limit of "
+                                 + std::to_string(maxNonzeros_));
+    }
+    if (closed_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    // Claim a slot whose sequence equals the enqueue position
+    uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            fullEvents_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    const size_t offset = static_cast<size_t>(pos & mask_) * maxNonzeros_;
+    slot->cost = column.cost;
+    slot->reducedCost = column.reducedCost;
+    slot->upperBound = column.upperBound;
+    slot->count = static_cast<int32_t>(column.rows.size());
+    for (size_t k = 0; k < column.rows.size(); ++k) {
+        rowSlab_[offset + k] = column.rows[k];
+        valueSlab_[offset + k] = column.values[k];
+    }
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ColumnQueue::push(const Column& column) {
+    // Spin briefly, then back off with short sleeps until the master drains
+    int attempts = 0;
+    while (!tryPush(column)) {
+        if (closed_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if (++attempts < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+    return true;
+}
+
+size_t ColumnQueue::drain(std::vector<Column>& out, size_t maxColumns) {
+    size_t count = 0;
+    while (count < maxColumns) {
+        Slot& slot = slots_[dequeuePos_ & mask_];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != dequeuePos_ + 1) {
+            break;      // Empty, or the producer of this slot has not finished writing
+        }
+
+        const size_t offset = static_cast<size_t>(dequeuePos_ & mask_) * maxNonzeros_;
+        Column column;
+        column.cost = slot.cost;
+        column.reducedCost = slot.reducedCost;
+        column.upperBound = slot.upperBound;
+        column.rows.assign(rowSlab_.begin() + offset, rowSlab_.begin() + offset + slot.count);
+        column.values.assign(valueSlab_.begin() + offset, valueSlab_.begin() + offset + slot.count);
+        out.push_back(std::move(column));
+
+        // Hand the slot back to producers one lap later
+        slot.sequence.store(dequeuePos_ + capacity_, std::memory_order_release);
+        ++dequeuePos_;
+        ++count;
+    }
+    drained_.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+size_t ColumnQueue::size() const {
+    const uint64_t drained = drained_.load(std::memory_order_relaxed);
+    const uint64_t pushed = pushed_.load(std::memory_order_relaxed);
+    return pushed > drained ? static_cast<size_t>(pushed - drained) : 0;
+}
+
+ColumnQueueStats ColumnQueue::getStats() const {
+    ColumnQueueStats stats;
+    stats.pushed = pushed_.load(std::memory_order_relaxed);
+    stats.drained = drained_.load(std::memory_order_relaxed);
+    stats.fullEvents = fullEvents_.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,168 @@
+#include "../include/column_store.hpp"
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+namespace {
+
+// Columns scanned per block; the block buffer stays in L1/L2
+constexpr size_t kScanBlock = 4096;
+
+} // namespace
+
+ColumnStore::ColumnStore(int numRows, bool unitCoefficients)
+    : numRows_(numRows), unitCoefficients_(unitCoefficients), start_(1, 0) {
+    if (numRows_ <= 0) {
+        throw std::runtime_error("Column store needs a positive number of rows");
+    }
+}
+
+void ColumnStore::reserve(size_t columns, size_t nonzeros) {
+    costs_.reserve(columns);
+    start_.reserve(columns + 1);
+    rowIndex_.reserve(nonzeros);
+    if (!unitCoefficients_) {
+        values_.reserve(nonzeros);
+    }
+}
+
+size_t ColumnStore::addColumn(double cost, const std::vector<int>& rows,
+                              const std::vector<double>& values) {
+    if (!unitCoefficients_ && values.size() != rows.size()) {
+        throw std::runtime_error("Column store rows and values size mismatch");
+    }
+    if (unitCoefficients_ && !values.empty()) {
+        for (double value : values) {
+            if (value != 1.0) {
+                throw std::runtime_error("Non-unit coefficient in unit-coefficient column store");
+            }
+        }
+    }
+    for (int row : rows) {
+        if (row < 0 || row >= numRows_) {
+            throw std::runtime_error("Column store row index out of range: " + std::to_string(row));
+        }
+    }
+
+    costs_.push_back(cost);
+    rowIndex_.insert(rowIndex_.end(), rows.begin(), rows.end());
+    if (!unitCoefficients_) {
+        for (double value : values) {
+            const float single = static_cast<float>(value);
+            if (exactValues_.empty() && static_cast<double>(single) != value) {
+                // Values so far were exact floats
+                exactValues_.assign(values_.begin(), values_.end());
+            }
+            values_.push_back(single);
+        }
+        if (!exactValues_.empty()) {
+            exactValues_.insert(exactValues_.end(), values.begin(), values.end());
+        }
+    }
+    start_.push_back(static_cast<int64_t>(rowIndex_.size()));
+    return costs_.size() - 1;
+}
+
+size_t ColumnStore::getMemoryBytes() const {
+    return costs_.capacity() * sizeof(double)
+         + start_.capacity() * sizeof(int64_t)
+         + rowIndex_.capacity() * sizeof(int32_t)
+         + values_.capacity() * sizeof(float)
+         + exactValues_.capacity() * sizeof(double);
+}
+
+Column ColumnStore::getColumn(size_t column) const {
+    if (column >= costs_.size()) {
+        throw std::runtime_error("Column store index out of range");
+    }
+    Column result;
+    result.cost = costs_[column];
+    for (int64_t k = start_[column]; k < start_[column + 1]; ++k) {
+        result.rows.push_back(rowIndex_[k]);
+        result.values.push_back(unitCoefficients_ ? 1.0 : value(k));
+    }
+    result.name = "store_" + std::to_string(column);
+    return result;
+}
+
+double ColumnStore::reducedCost(const double* duals, size_t column) const {
+    double sum = 0.0;
+    for (int64_t k = start_[column]; k < start_[column + 1]; ++k) {
+        sum += duals[rowIndex_[k]] * (unitCoefficients_ ? 1.0 : value(k));
+    }
+    return costs_[column] - sum;
+}
+
+void ColumnStore::reducedCosts(const double* duals, size_t begin, size_t end, double* out) const {
+    const double* costs = costs_.data();
+    const int64_t* start = start_.data();
+    const int32_t* rowIndex = rowIndex_.data();
+
+    if (unitCoefficients_) {
+        for (size_t j = begin; j < end; ++j) {
+            double sum = 0.0;
+            for (int64_t k = start[j]; k < start[j + 1]; ++k) {
+                sum += duals[rowIndex[k]];
+            }
+            out[j - begin] = costs[j] - sum;
+        }
+        return;
+    }
+
+    const float* values = values_.data();
+    for (size_t j = begin; j < end; ++j) {
+        double sum = 0.0;
+        for (int64_t k = start[j]; k < start[j + 1]; ++k) {
+            sum += duals[rowIndex[k]] * static_cast<double>(values[k]);
+        }
+        out[j - begin] = costs[j] - sum;
+    }
+}
+
+ColumnStorePricer::ColumnStorePricer(const ColumnStore& store, int maxColumns, double tolerance)
+    : store_(store), maxColumns_(maxColumns), tolerance_(tolerance),
+      multiplicity_(std::numeric_limits<double>::infinity()), buffer_(kScanBlock) {
+    if (maxColumns_ <= 0) {
+        throw std::runtime_error("Column store pricer must return at least one column");
+    }
+}
+
+double ColumnStorePricer::price(const std::vector<double>& duals, std::vector<Column>& columns) {
+    if (static_cast<int>(duals.size()) != store_.getNumRows()) {
+        throw std::runtime_error("Dual vector size does not match column store rows");
+    }
+
+    // Max-heap on reduced cost keeps the maxColumns_ most negative candidates
+    using Entry = std::pair<double, size_t>;
+    std::priority_queue<Entry> best;
+    double minReducedCost = std::numeric_limits<double>::infinity();
+
+    const size_t total = store_.size();
+    for (size_t begin = 0; begin < total; begin += kScanBlock) {
+        const size_t end = std::min(total, begin + kScanBlock);
+        store_.reducedCosts(duals.data(), begin, end, buffer_.data());
+
+        for (size_t j = begin; j < end; ++j) {
+            const double reducedCost = buffer_[j - begin];
+            minReducedCost = std::min(minReducedCost, reducedCost);
+            if (reducedCost >= -tolerance_) {
+                continue;
+            }
+            if (static_cast<int>(best.size()) < maxColumns_) {
+                best.emplace(reducedCost, j);
+            } else if (reducedCost < best.top().first) {
+                best.pop();
+                best.emplace(reducedCost, j);
+            }
+        }
+    }
+
+    while (!best.empty()) {
+        Column column = store_.getColumn(best.top().second);
+        column.reducedCost = store_.reducedCost(duals.data(), best.top().second);
+        columns.push_back(std::move(column));
+        best.pop();
+    }
+    return minReducedCost;
+}
@@ -0,0 +1,606 @@
+#include "../include/dw_decomposition.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+// Union-find over columns that also tracks the number and largest size of components
+class ComponentTracker {
+private:
+    std::vector<int> parent_;
+    std::vector<int> size_;
+    int components_;
+    int largest_;
+
+public:
+    explicit ComponentTracker(int n)
+        : parent_(n), size_(n, 1), components_(n), largest_(n > 0 ? 1 : 0) {
+        std::iota(parent_.begin(), parent_.end(), 0);
+    }
+
+    int find(int x) {
+        while (parent_[x] != x) {
+            parent_[x] = parent_[parent_[x]];
+            x = parent_[x];
+        }
+        return x;
+    }
+
+    void unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return;
+        }
+        if (size_[a] < size_[b]) {
+            std::swap(a, b);
+        }
+        parent_[b] = a;
+        size_[a] += size_[b];
+        largest_ = std::max(largest_, size_[a]);
+        --components_;
+    }
+
+    int getComponents() const { return components_; }
+    int getLargest() const { return largest_; }
+};
+
+std::unordered_map<SCIP_VAR*, int> indexColumns(const std::vector<ScipVariable*>& columns) {
+    std::unordered_map<SCIP_VAR*, int> index;
+    index.reserve(columns.size());
+    for (size_t j = 0; j < columns.size(); ++j) {
+        if (columns[j] == nullptr) {
+            throw std::runtime_error("Null variable pointer in decomposition");
+        }
+        index[columns[j]->get()] = static_cast<int>(j);
+    }
+    return index;
+}
+
+// Appends raw bytes of a value to a block signature
+template <typename T>
+void appendKey(std::string& key, const T& value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+} // namespace
+
+DecompositionStructure DecompositionDetector::detect(const std::vector<ScipConstraint*>& rows,
+                                                     const std::vector<ScipVariable*>& columns,
+                                                     const DecompositionParams& params) {
+    const int numRows = static_cast<int>(rows.size());
+    const int numCols = static_cast<int>(columns.size());
+    if (numRows == 0 || numCols == 0) {
+        throw std::runtime_error("Cannot decompose an empty model");
+    }
+
+    // 1. Hyperedges: the columns of every row
+    const auto columnIndex = indexColumns(columns);
+    std::vector<std::vector<int>> rowColumns(numRows);
+    for (int i = 0; i < numRows; ++i) {
+        if (rows[i] == nullptr) {
+            throw std::runtime_error("Null constraint pointer in decomposition");
+        }
+        for (SCIP_VAR* var : rows[i]->getRawVariables()) {
+            auto it = columnIndex.find(var);
+            if (it == columnIndex.end()) {
+                throw std::runtime_error("Row " + rows[i]->getName() + " uses an unknown column");
+            }
+            rowColumns[i].push_back(it->second);
+        }
+    }
+
+    // 2. Rows from sparsest to densest; the densest ones are the linking candidates
+    std::vector<int> order(numRows);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return rowColumns[a].size() < rowColumns[b].size();
+    });
+
+    // 3. Add rows one by one; after p rows the remaining numRows - p are linking
+    const int maxLinking = static_cast<int>(params.maxLinkingFraction * numRows);
+    int bestPrefix = -1;
+    double bestScore = std::numeric_limits<double>::infinity();
+    ComponentTracker tracker(numCols);
+    for (int p = 0; p <= numRows; ++p) {
+        if (p > 0) {
+            const auto& cols = rowColumns[order[p - 1]];
+            for (size_t k = 1; k < cols.size(); ++k) {
+                tracker.unite(cols[0], cols[k]);
+            }
+        }
+        if (numRows - p > maxLinking || tracker.getComponents() < 2) {
+            continue;
+        }
+        const double score = static_cast<double>(numRows - p) / numRows
+                           + static_cast<double>(tracker.getLargest()) / numCols;
+        if (score < bestScore) {
+            bestScore = score;
+            bestPrefix = p;
+        }
+    }
+    if (bestPrefix < 0) {
+        throw std::runtime_error("No block-diagonal structure within the linking row limit");
+    }
+
+    // 4. Components of the chosen cut
+    ComponentTracker chosen(numCols);
+    for (int p = 0; p < bestPrefix; ++p) {
+        const auto& cols = rowColumns[order[p]];
+        for (size_t k = 1; k < cols.size(); ++k) {
+            chosen.unite(cols[0], cols[k]);
+        }
+    }
+    std::unordered_map<int, std::vector<int>> components;
+    for (int j = 0; j < numCols; ++j) {
+        components[chosen.find(j)].push_back(j);
+    }
+
+    // 5. Pack components into at most maxBlocks blocks (largest first into the lightest)
+    std::vector<std::vector<int>> parts;
+    for (auto& entry : components) {
+        parts.push_back(std::move(entry.second));
+    }
+    std::sort(parts.begin(), parts.end(), [](const std::vector<int>& a, const std::vector<int>& b) {
+        return a.size() > b.size() || (a.size() == b.size() && a.front() < b.front());
+    });
+    const size_t numBlocks = std::min(parts.size(), static_cast<size_t>(std::max(1, params.maxBlocks)));
+
+    DecompositionStructure structure;
+    structure.blockColumns.resize(numBlocks);
+    for (auto& part : parts) {
+        auto lightest = std::min_element(structure.blockColumns.begin(), structure.blockColumns.end(),
+                                         [](const std::vector<int>& a, const std::vector<int>& b) {
+                                             return a.size() < b.size();
+                                         });
+        lightest->insert(lightest->end(), part.begin(), part.end());
+    }
+
+    std::vector<int> blockOf(numCols);
+    for (size_t b = 0; b < numBlocks; ++b) {
+        std::sort(structure.blockColumns[b].begin(), structure.blockColumns[b].end());
+        for (int j : structure.blockColumns[b]) {
+            blockOf[j] = static_cast<int>(b);
+        }
+    }
+
+    structure.blockRows.resize(numBlocks);
+    for (int p = 0; p < numRows; ++p) {
+        const int row = order[p];
+        // Rows without variables belong to no block; the master keeps them
+        if (p < bestPrefix && !rowColumns[row].empty()) {
+            structure.blockRows[blockOf[rowColumns[row][0]]].push_back(row);
+        } else {
+            structure.linkingRows.push_back(row);
+        }
+    }
+    std::sort(structure.linkingRows.begin(), structure.linkingRows.end());
+    for (auto& blockRows : structure.blockRows) {
+        std::sort(blockRows.begin(), blockRows.end());
+    }
+    return structure;
+}
+
+std::vector<std::vector<int>> findIdenticalBlocks(const std::vector<ScipConstraint*>& rows,
+                                                  const std::vector<ScipVariable*>& columns,
+                                                  const DecompositionStructure& structure) {
+    const std::unordered_map<SCIP_VAR*, int> columnIndex = indexColumns(columns);
+    std::vector<int> localPosition(columns.size(), -1);
+    for (const std::vector<int>& blockColumns : structure.blockColumns) {
+        for (size_t pos = 0; pos < blockColumns.size(); ++pos) {
+            localPosition[blockColumns[pos]] = static_cast<int>(pos);
+        }
+    }
+    std::vector<int> blockOf(columns.size(), -1);
+    for (int b = 0; b < structure.getNumBlocks(); ++b) {
+        for (int j : structure.blockColumns[b]) {
+            blockOf[j] = b;
+        }
+    }
+
+    // Linking entries per block as (linking position, local column, coefficient)
+    std::vector<std::string> linkKeys(structure.getNumBlocks());
+    for (size_t pos = 0; pos < structure.linkingRows.size(); ++pos) {
+        const ScipConstraint* row = rows[structure.linkingRows[pos]];
+        std::vector<std::vector<std::pair<int, double>>> entries(structure.getNumBlocks());
+        const auto& vars = row->getRawVariables();
+        const auto& coeffs = row->getCoefficients();
+        for (size_t k = 0; k < vars.size(); ++k) {
+            auto it = columnIndex.find(vars[k]);
+            if (it != columnIndex.end() && blockOf[it->second] >= 0) {
+                entries[blockOf[it->second]].emplace_back(localPosition[it->second], coeffs[k]);
+            }
+        }
+        for (int b = 0; b < structure.getNumBlocks(); ++b) {
+            std::sort(entries[b].begin(), entries[b].end());
+            appendKey(linkKeys[b], static_cast<int>(pos));
+            appendKey(linkKeys[b], static_cast<int>(entries[b].size()));
+            for (const auto& entry : entries[b]) {
+                appendKey(linkKeys[b], entry.first);
+                appendKey(linkKeys[b], entry.second);
+            }
+        }
+    }
+
+    std::map<std::string, std::vector<int>> groups;
+    std::vector<std::string> order;
+    for (int b = 0; b < structure.getNumBlocks(); ++b) {
+        std::string key;
+        appendKey(key, static_cast<int>(structure.blockColumns[b].size()));
+        for (int j : structure.blockColumns[b]) {
+            const ScipVariable* column = columns[j];
+            appendKey(key, column->getLowerBound());
+            appendKey(key, column->getUpperBound());
+            appendKey(key, static_cast<int>(column->getType()));
+            appendKey(key, column->getObjective());
+        }
+        appendKey(key, static_cast<int>(structure.blockRows[b].size()));
+        for (int i : structure.blockRows[b]) {
+            const ScipConstraint* row = rows[i];
+            std::vector<std::pair<int, double>> entries;
+            const auto& vars = row->getRawVariables();
+            const auto& coeffs = row->getCoefficients();
+            for (size_t k = 0; k < vars.size(); ++k) {
+                entries.emplace_back(localPosition[columnIndex.at(vars[k])], coeffs[k]);
+            }
+            std::sort(entries.begin(), entries.end());
+            appendKey(key, row->getLhs());
+            appendKey(key, row->getRhs());
+            appendKey(key, static_cast<int>(entries.size()));
+            for (const auto& entry : entries) {
+                appendKey(key, entry.first);
+                appendKey(key, entry.second);
+            }
+        }
+        key += linkKeys[b];
+
+        std::vector<int>& group = groups[key];
+        if (group.empty()) {
+            order.push_back(key);
+        }
+        group.push_back(b);
+    }
+
+    // Orbits in order of their first block
+    std::vector<std::vector<int>> orbits;
+    orbits.reserve(order.size());
+    for (const std::string& key : order) {
+        orbits.push_back(std::move(groups[key]));
+    }
+    return orbits;
+}
+
+DantzigWolfeBlockPricer::DantzigWolfeBlockPricer(int block, int convexityRow,
+                                                 const std::vector<ScipConstraint*>& compactRows,
+                                                 const std::vector<ScipVariable*>& compactColumns,
+                                                 const DecompositionStructure& structure,
+                                                 const std::vector<int>& masterRowOfLinking,
+                                                 int multiplicity)
+    : block_(block),
+      convexityRow_(convexityRow),
+      sub_("dw_block_" + std::to_string(block)),
+      generated_(0),
+      multiplicity_(multiplicity) {
+    sub_.setVerbosity(0);
+
+    // 1. Copies of the block columns (objective is set per pricing call)
+    const std::vector<int>& blockColumns = structure.blockColumns.at(block);
+    std::unordered_map<SCIP_VAR*, int> local;
+    vars_.reserve(blockColumns.size());
+    for (int j : blockColumns) {
+        const ScipVariable* column = compactColumns[j];
+        local[column->get()] = static_cast<int>(vars_.size());
+        vars_.push_back(sub_.createVariable(column->getName(), column->getLowerBound(),
+                                            column->getUpperBound(), 0.0, column->getType()));
+        costs_.push_back(column->getObjective());
+    }
+
+    // 2. Block rows become the sub-MIP constraints
+    cons_.reserve(structure.blockRows.at(block).size());
+    for (int i : structure.blockRows[block]) {
+        const ScipConstraint* row = compactRows[i];
+        std::vector<ScipVariable*> vars;
+        for (SCIP_VAR* var : row->getRawVariables()) {
+            auto it = local.find(var);
+            if (it == local.end()) {
+                throw std::runtime_error("Block row " + row->getName() + " leaves its block");
+            }
+            vars.push_back(&vars_[it->second]);
+        }
+        cons_.push_back(sub_.createConstraint(row->getName(), vars, row->getCoefficients(),
+                                              row->getLhs(), row->getRhs()));
+    }
+
+    // 3. Linking-row coefficients per block column
+    links_.resize(vars_.size());
+    for (size_t pos = 0; pos < structure.linkingRows.size(); ++pos) {
+        const ScipConstraint* row = compactRows[structure.linkingRows[pos]];
+        const auto& vars = row->getRawVariables();
+        const auto& coeffs = row->getCoefficients();
+        for (size_t k = 0; k < vars.size(); ++k) {
+            auto it = local.find(vars[k]);
+            if (it != local.end()) {
+                links_[it->second].push_back(LinkEntry{masterRowOfLinking[pos], coeffs[k]});
+            }
+        }
+    }
+}
+
+Column DantzigWolfeBlockPricer::makeColumn(const std::vector<double>& point) const {
+    Column column;
+    std::map<int, double> coefficients;
+    for (size_t j = 0; j < vars_.size(); ++j) {
+        if (point[j] == 0.0) {
+            continue;
+        }
+        column.cost += costs_[j] * point[j];
+        for (const LinkEntry& link : links_[j]) {
+            coefficients[link.masterRow] += link.coefficient * point[j];
+        }
+    }
+    for (const auto& entry : coefficients) {
+        if (std::fabs(entry.second) > 1e-12) {
+            column.rows.push_back(entry.first);
+            column.values.push_back(entry.second);
+        }
+    }
+    column.rows.push_back(convexityRow_);
+    column.values.push_back(1.0);
+    return column;
+}
+
+double DantzigWolfeBlockPricer::price(const std::vector<double>& duals, std::vector<Column>& columns) {
+    // 1. Reduced-cost objective: c_j - sum over linking rows of dual * coefficient
+    sub_.freeTransform();
+    for (size_t j = 0; j < vars_.size(); ++j) {
+        double objective = costs_[j];
+        for (const LinkEntry& link : links_[j]) {
+            objective -= duals[link.masterRow] * link.coefficient;
+        }
+        vars_[j].setObjective(objective);
+    }
+
+    // 2. Sub-MIP
+    sub_.solve();
+    const SCIP_STATUS status = sub_.getStatus();
+    if (status == SCIP_STATUS_INFEASIBLE) {
+        throw std::runtime_error("Dantzig-Wolfe block " + std::to_string(block_) + " is infeasible");
+    }
+    if (status == SCIP_STATUS_UNBOUNDED || status == SCIP_STATUS_INFORUNBD) {
+        throw std::runtime_error("Dantzig-Wolfe block " + std::to_string(block_)
+                                 + " is unbounded; bounded blocks are required");
+    }
+
+    const double convexityDual = duals[convexityRow_];
+    const double bound = (status == SCIP_STATUS_OPTIMAL)
+        ? sub_.getObjectiveValue() - convexityDual
+        : SCIPgetDualbound(sub_.get()) - convexityDual;
+    if (SCIPgetBestSol(sub_.get()) == nullptr) {
+        return bound;
+    }
+
+    // 3. Column from the best block point
+    const double reducedCost = sub_.getObjectiveValue() - convexityDual;
+    if (reducedCost < 0.0) {
+        std::vector<double> point(vars_.size());
+        for (size_t j = 0; j < vars_.size(); ++j) {
+            point[j] = vars_[j].getSolutionValue();
+        }
+        Column column = makeColumn(point);
+        column.reducedCost = reducedCost;
+        column.name = "dw_b" + std::to_string(block_) + "_" + std::to_string(generated_++);
+        solutions_[column.name] = std::move(point);
+        columns.push_back(std::move(column));
+    }
+    return bound;
+}
+
+const std::vector<double>* DantzigWolfeBlockPricer::findSolution(const std::string& columnName) const {
+    auto it = solutions_.find(columnName);
+    return (it == solutions_.end()) ? nullptr : &it->second;
+}
+
+DantzigWolfeSolver::DantzigWolfeSolver(ScipSolver& compact,
+                                       const std::vector<ScipConstraint*>& rows,
+                                       const std::vector<ScipVariable*>& columns,
+                                       const DantzigWolfeParams& params)
+    : compactRows_(rows),
+      compactColumns_(columns),
+      params_(params),
+      master_("dw_master") {
+    if (SCIPgetObjsense(compact.get()) != SCIP_OBJSENSE_MINIMIZE) {
+        throw std::runtime_error("Dantzig-Wolfe reformulation expects a minimization model");
+    }
+    master_.setColumnGenerationMode();
+}
+
+void DantzigWolfeSolver::setStructure(const DecompositionStructure& structure) {
+    if (cg_) {
+        throw std::runtime_error("Decomposition structure must be set before solving");
+    }
+    structure_ = structure;
+}
+
+void DantzigWolfeSolver::buildMaster() {
+    SCIP* scip = master_.get();
+    const double cost = params_.artificialCost;
+    std::vector<ScipConstraint*> rows;
+
+    // 1. Linking rows, each kept feasible by slack columns in the directions it bounds
+    std::vector<int> masterRowOfLinking;
+    for (int i : structure_.linkingRows) {
+        const ScipConstraint* row = compactRows_[i];
+        const double lhs = row->getLhs();
+        const double rhs = row->getRhs();
+        std::vector<ScipVariable*> vars;
+        std::vector<double> coeffs;
+        if (!SCIPisInfinity(scip, -lhs)) {
+            artificials_.push_back(master_.createVariable("art_lhs_" + row->getName(),
+                                                          0.0, SCIPinfinity(scip), cost));
+            vars.push_back(&artificials_.back());
+            coeffs.push_back(1.0);
+        }
+        if (!SCIPisInfinity(scip, rhs)) {
+            artificials_.push_back(master_.createVariable("art_rhs_" + row->getName(),
+                                                          0.0, SCIPinfinity(scip), cost));
+            vars.push_back(&artificials_.back());
+            coeffs.push_back(-1.0);
+        }
+        masterRows_.push_back(master_.createConstraint(row->getName(), vars, coeffs, lhs, rhs));
+        masterRowOfLinking.push_back(static_cast<int>(rows.size()));
+        rows.push_back(&masterRows_.back());
+    }
+
+    // 2. Convexity rows and the block pricers, one per orbit of identical blocks
+    if (params_.aggregateIdenticalBlocks) {
+        orbits_ = findIdenticalBlocks(compactRows_, compactColumns_, structure_);
+    } else {
+        orbits_.clear();
+        for (int b = 0; b < structure_.getNumBlocks(); ++b) {
+            orbits_.push_back({b});
+        }
+    }
+    for (const std::vector<int>& orbit : orbits_) {
+        const int b = orbit.front();
+        const double size = static_cast<double>(orbit.size());
+        artificials_.push_back(master_.createVariable("art_conv_" + std::to_string(b),
+                                                      0.0, SCIPinfinity(scip), cost));
+        std::vector<ScipVariable*> vars = {&artificials_.back()};
+        masterRows_.push_back(master_.createConstraint("convexity_" + std::to_string(b),
+                                                       vars, {1.0}, size, size));
+        const int convexityRow = static_cast<int>(rows.size());
+        rows.push_back(&masterRows_.back());
+        pricers_.push_back(std::make_unique<DantzigWolfeBlockPricer>(
+            b, convexityRow, compactRows_, compactColumns_, structure_, masterRowOfLinking,
+            static_cast<int>(orbit.size())));
+    }
+
+    cg_ = std::make_unique<ColumnGeneration>(master_, rows);
+    for (auto& pricer : pricers_) {
+        cg_->addOracle(pricer.get());
+    }
+}
+
+ColumnGenerationStats DantzigWolfeSolver::solve() {
+    if (!cg_) {
+        if (structure_.blockColumns.empty()) {
+            structure_ = DecompositionDetector::detect(compactRows_, compactColumns_, params_.detection);
+        }
+        buildMaster();
+    }
+    return cg_->run(params_.columnGeneration);
+}
+
+std::vector<double> DantzigWolfeSolver::getCompactSolution() {
+    if (!cg_) {
+        throw std::runtime_error("Dantzig-Wolfe master not solved yet");
+    }
+    // Positive lambdas and their block points per orbit
+    std::vector<std::vector<std::pair<double, const std::vector<double>*>>> used(pricers_.size());
+    for (int c = 0; c < cg_->getNumColumns(); ++c) {
+        const double lambda = cg_->getColumn(c).getSolutionValue();
+        if (lambda == 0.0) {
+            continue;
+        }
+        const std::string& name = cg_->getColumnData(c).name;
+        for (size_t o = 0; o < pricers_.size(); ++o) {
+            const std::vector<double>* point = pricers_[o]->findSolution(name);
+            if (point != nullptr) {
+                used[o].emplace_back(lambda, point);
+                break;
+            }
+        }
+    }
+
+    std::vector<double> values(compactColumns_.size(), 0.0);
+    auto addPoint = [&](int block, double weight, const std::vector<double>& point) {
+        const std::vector<int>& blockColumns = structure_.blockColumns[block];
+        for (size_t j = 0; j < blockColumns.size(); ++j) {
+            values[blockColumns[j]] += weight * point[j];
+        }
+    };
+    for (size_t o = 0; o < used.size(); ++o) {
+        const std::vector<int>& orbit = orbits_[o];
+        bool integral = true;
+        double units = 0.0;
+        for (const auto& entry : used[o]) {
+            integral = integral && std::fabs(entry.first - std::round(entry.first)) <= 1e-6;
+            units += std::round(entry.first);
+        }
+        if (integral && units <= orbit.size() + 1e-6) {
+            // Integral master: every unit of a column is one whole block of the orbit
+            size_t next = 0;
+            for (const auto& entry : used[o]) {
+                for (long k = std::lround(entry.first); k > 0; --k) {
+                    addPoint(orbit[next++], 1.0, *entry.second);
+                }
+            }
+        } else {
+            // Fractional LP point: each block takes an equal share of the combination
+            for (const auto& entry : used[o]) {
+                for (int block : orbit) {
+                    addPoint(block, entry.first / static_cast<double>(orbit.size()), *entry.second);
+                }
+            }
+        }
+    }
+    return values;
+}
+
+AggregatedBranchingCandidate DantzigWolfeSolver::findBranchingCandidate(double tolerance) {
+    if (!cg_) {
+        throw std::runtime_error("Dantzig-Wolfe master not solved yet");
+    }
+    std::vector<std::vector<double>> sums(pricers_.size());
+    for (size_t o = 0; o < pricers_.size(); ++o) {
+        sums[o].assign(structure_.blockColumns[orbits_[o].front()].size(), 0.0);
+    }
+    for (int c = 0; c < cg_->getNumColumns(); ++c) {
+        const double lambda = cg_->getColumn(c).getSolutionValue();
+        if (lambda == 0.0) {
+            continue;
+        }
+        const std::string& name = cg_->getColumnData(c).name;
+        for (size_t o = 0; o < pricers_.size(); ++o) {
+            const std::vector<double>* point = pricers_[o]->findSolution(name);
+            if (point != nullptr) {
+                for (size_t j = 0; j < point->size(); ++j) {
+                    sums[o][j] += lambda * (*point)[j];
+                }
+                break;
+            }
+        }
+    }
+
+    AggregatedBranchingCandidate best;
+    double bestFractionality = tolerance;
+    for (size_t o = 0; o < sums.size(); ++o) {
+        const std::vector<int>& blockColumns = structure_.blockColumns[orbits_[o].front()];
+        for (size_t j = 0; j < sums[o].size(); ++j) {
+            if (compactColumns_[blockColumns[j]]->getType() == SCIP_VARTYPE_CONTINUOUS) {
+                continue;
+            }
+            const double fractionality = std::fabs(sums[o][j] - std::round(sums[o][j]));
+            if (fractionality > bestFractionality) {
+                bestFractionality = fractionality;
+                best.orbit = static_cast<int>(o);
+                best.blockColumn = static_cast<int>(j);
+                best.value = sums[o][j];
+            }
+        }
+    }
+    return best;
+}
+
+bool DantzigWolfeSolver::usesArtificials() {
+    for (const ScipVariable& artificial : artificials_) {
+        if (artificial.getSolutionValue() > 1e-6) {
+            return true;
+        }
+    }
+    return false;
+}
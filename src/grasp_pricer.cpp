@@ -0,0 +1,325 @@
+#include "../include/grasp_pricer.hpp"
+#include "../include/pricing_replicas.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+constexpr double kEpsilon = 1e-9;
+
+} // namespace
+
+GraspPricer::GraspPricer(const PricingGraph& graph, TaskScheduler& scheduler,
+                         const GraspParams& params, const std::string& name)
+    : graph_(graph), replicas_(nullptr), scheduler_(scheduler), params_(params), name_(name),
+      collector_(std::max(params.maxColumns, 1), params.tolerance), fallback_(nullptr),
+      arcTo_(graph.getNumNodes()), calls_(0), nextSeedCall_(1), seedCall_(0),
+      fallbackCalls_(0), restarts_(0),
+      offered_(0), improved_(0) {
+    if (!graph.isFinalized()) {
+        throw std::runtime_error("GRASP pricer needs a finalized pricing graph");
+    }
+    if (params.alpha < 0.0 || params.alpha > 1.0) {
+        throw std::runtime_error("GRASP alpha must lie in [0, 1]");
+    }
+    for (int a = 0; a < graph.getNumArcs(); ++a) {
+        arcTo_[graph.getTail(a)].emplace_back(graph.getHead(a), a);
+    }
+    for (auto& arcs : arcTo_) {
+        std::sort(arcs.begin(), arcs.end());
+    }
+    for (int i = 0; i < graph.getNumNodes(); ++i) {
+        if (graph.node(i).row >= 0 && i != graph.getSource() && i != graph.getSink()) {
+            customers_.push_back(i);
+        }
+    }
+}
+
+void GraspPricer::setReplicas(PricingReplicas* replicas) {
+    if (replicas != nullptr
+        && (replicas->getReplica(0).graph.getNumArcs() != graph_.getNumArcs()
+            || replicas->getReplica(0).graph.getNumNodes() != graph_.getNumNodes())) {
+        throw std::runtime_error("GRASP replicas come from a different pricing graph");
+    }
+    replicas_ = replicas;
+}
+
+int GraspPricer::findArc(const View& view, int tail, int head) const {
+    const auto& arcs = arcTo_[tail];
+    for (auto it = std::lower_bound(arcs.begin(), arcs.end(), std::make_pair(head, -1));
+         it != arcs.end() && it->first == head; ++it) {
+        if (view.graph.isActive(it->second)) {
+            return it->second;
+        }
+    }
+    return -1;
+}
+
+double GraspPricer::evaluate(const View& view, const std::vector<int>& route) const {
+    int tail = view.graph.getSource();
+    double time = view.graph.node(tail).earliest;
+    double load = view.graph.node(tail).demand;
+    double value = -view.pathDual;
+    for (size_t k = 0; k <= route.size(); ++k) {
+        const int head = k < route.size() ? route[k] : view.graph.getSink();
+        const int arc = findArc(view, tail, head);
+        if (arc < 0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        const PricingGraph::Node& node = view.graph.node(head);
+        load += node.demand;
+        time = std::max(node.earliest, view.graph.getArrivalTime(arc, time + view.graph.node(tail).service));
+        if (load > view.graph.getCapacity() + kEpsilon || time > node.latest) {
+            return std::numeric_limits<double>::infinity();
+        }
+        value += view.reducedCost[arc];
+        tail = head;
+    }
+    return value;
+}
+
+void GraspPricer::construct(const View& view, std::mt19937& rng, std::vector<int>& route,
+                            std::vector<char>& inRoute) const {
+    const int sink = view.graph.getSink();
+    int current = view.graph.getSource();
+    double time = view.graph.node(current).earliest;
+    double load = view.graph.node(current).demand;
+    double value = -view.pathDual;
+    double bestValue = std::numeric_limits<double>::infinity();
+    size_t bestLength = 0;
+    std::vector<std::pair<double, int>> candidates;     // (arc reduced cost, arc)
+    while (true) {
+        // Closing the route here is a candidate prefix
+        const int closing = findArc(view, current, sink);
+        if (closing >= 0) {
+            const PricingGraph::Node& node = view.graph.node(sink);
+            const double arrival = std::max(node.earliest, view.graph.getArrivalTime(
+                closing, time + view.graph.node(current).service));
+            if (arrival <= node.latest && load + node.demand <= view.graph.getCapacity() + kEpsilon
+                && value + view.reducedCost[closing] < bestValue) {
+                bestValue = value + view.reducedCost[closing];
+                bestLength = route.size();
+            }
+        }
+
+        candidates.clear();
+        const auto range = view.graph.outArcs(current);
+        for (const int* it = range.first; it != range.second; ++it) {
+            const int head = view.graph.getHead(*it);
+            if (!view.graph.isActive(*it) || head == sink || head == view.graph.getSource() || inRoute[head]) {
+                continue;
+            }
+            const PricingGraph::Node& node = view.graph.node(head);
+            const double arrival = std::max(node.earliest, view.graph.getArrivalTime(
+                *it, time + view.graph.node(current).service));
+            if (arrival <= node.latest && load + node.demand <= view.graph.getCapacity() + kEpsilon) {
+                candidates.emplace_back(view.reducedCost[*it], *it);
+            }
+        }
+        if (candidates.empty()) {
+            break;
+        }
+
+        // Draw uniformly from the restricted candidate list
+        double best = candidates[0].first;
+        double worst = candidates[0].first;
+        for (const auto& candidate : candidates) {
+            best = std::min(best, candidate.first);
+            worst = std::max(worst, candidate.first);
+        }
+        const double limit = best + params_.alpha * (worst - best);
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                        [limit](const std::pair<double, int>& candidate) {
+                                            return candidate.first > limit;
+                                        }),
+                         candidates.end());
+        const int arc = candidates[std::uniform_int_distribution<size_t>(
+            0, candidates.size() - 1)(rng)].second;
+        const int head = view.graph.getHead(arc);
+        const PricingGraph::Node& node = view.graph.node(head);
+        time = std::max(node.earliest, view.graph.getArrivalTime(arc, time + view.graph.node(current).service));
+        load += node.demand;
+        value += view.reducedCost[arc];
+        route.push_back(head);
+        inRoute[head] = 1;
+        current = head;
+    }
+
+    // Keep the best closable prefix
+    for (size_t k = bestLength; k < route.size(); ++k) {
+        inRoute[route[k]] = 0;
+    }
+    route.resize(bestLength);
+}
+
+double GraspPricer::localSearch(const View& view, std::mt19937& rng, std::vector<int>& route,
+                                std::vector<char>& inRoute, double value) const {
+    const double tolerance = params_.tolerance;
+    std::vector<int> order(customers_);
+    std::vector<int> candidate;
+    auto accept = [&](double newValue) {
+        if (newValue >= value - tolerance) {
+            return false;
+        }
+        route.swap(candidate);
+        value = newValue;
+        return true;
+    };
+
+    for (int round = 0; round < params_.localSearchRounds; ++round) {
+        bool improved = false;
+        std::shuffle(order.begin(), order.end(), rng);
+
+        // Remove a customer
+        for (size_t k = 0; k < route.size();) {
+            candidate = route;
+            candidate.erase(candidate.begin() + k);
+            const int removed = route[k];
+            if (accept(evaluate(view, candidate))) {
+                inRoute[removed] = 0;
+                improved = true;
+            } else {
+                ++k;
+            }
+        }
+
+        // Insert an unvisited customer with a positive dual at its best position, or let
+        // it replace a visited one
+        for (int customer : order) {
+            if (inRoute[customer] || view.duals[view.graph.node(customer).row] <= 0.0) {
+                continue;
+            }
+            double bestValue = value - tolerance;
+            std::vector<int> best;
+            int replaced = -1;
+            for (size_t k = 0; k <= route.size(); ++k) {
+                candidate = route;
+                candidate.insert(candidate.begin() + k, customer);
+                const double inserted = evaluate(view, candidate);
+                if (inserted < bestValue) {
+                    bestValue = inserted;
+                    best = candidate;
+                    replaced = -1;
+                }
+                if (k < route.size()) {
+                    candidate.erase(candidate.begin() + k + 1);
+                    const double swapped = evaluate(view, candidate);
+                    if (swapped < bestValue) {
+                        bestValue = swapped;
+                        best = candidate;
+                        replaced = route[k];
+                    }
+                }
+            }
+            if (!best.empty()) {
+                candidate.swap(best);
+                accept(bestValue);
+                inRoute[customer] = 1;
+                if (replaced >= 0) {
+                    inRoute[replaced] = 0;
+                }
+                improved = true;
+            }
+        }
+        if (!improved) {
+            break;
+        }
+    }
+    return value;
+}
+
+void GraspPricer::offer(const View& view, const std::vector<int>& route) {
+    std::vector<std::pair<int, double>> entries;
+    Column column;
+    int tail = view.graph.getSource();
+    for (size_t k = 0; k <= route.size(); ++k) {
+        const int head = k < route.size() ? route[k] : view.graph.getSink();
+        column.cost += view.graph.getCost(findArc(view, tail, head));
+        if (view.graph.node(head).row >= 0) {
+            entries.emplace_back(view.graph.node(head).row, 1.0);
+        }
+        tail = head;
+    }
+    if (view.graph.getConvexityRow() >= 0) {
+        entries.emplace_back(view.graph.getConvexityRow(), 1.0);
+    }
+    std::sort(entries.begin(), entries.end());
+    column.reducedCost = column.cost;
+    for (const auto& entry : entries) {
+        column.rows.push_back(entry.first);
+        column.values.push_back(entry.second);
+        column.reducedCost -= view.duals.at(entry.first) * entry.second;
+    }
+    offered_.fetch_add(1, std::memory_order_relaxed);
+    collector_.offer(std::move(column));
+}
+
+void GraspPricer::runRestart(const View& view, uint64_t restart) {
+    std::seed_seq seed{params_.seed, static_cast<unsigned>(seedCall_), static_cast<unsigned>(restart)};
+    std::mt19937 rng(seed);
+    std::vector<int> route;
+    std::vector<char> inRoute(view.graph.getNumNodes(), 0);
+
+    construct(view, rng, route, inRoute);
+    const double constructed = evaluate(view, route);
+    if (!std::isfinite(constructed)) {
+        return;
+    }
+    if (collector_.accepts(constructed)) {
+        offer(view, route);
+    }
+    const double improved = localSearch(view, rng, route, inRoute, constructed);
+    if (improved < constructed) {
+        improved_.fetch_add(1, std::memory_order_relaxed);
+        if (collector_.accepts(improved)) {
+            offer(view, route);
+        }
+    }
+}
+
+double GraspPricer::price(const std::vector<double>& duals, std::vector<Column>& columns) {
+    ++calls_;
+    seedCall_ = nextSeedCall_++;
+    const size_t restarts = static_cast<size_t>(std::max(params_.restarts, 0));
+    if (replicas_ != nullptr) {
+        // Every node's replica computes its own arc reduced costs in local memory
+        replicas_->publishDuals(duals);
+        scheduler_.parallelFor(0, restarts, params_.grain, [this](size_t begin, size_t end) {
+            const PricingReplica& replica = replicas_->local();
+            const View view{replica.graph, replica.duals, replica.arcReducedCosts, replica.pathDual};
+            for (size_t r = begin; r < end; ++r) {
+                runRestart(view, r);
+            }
+        });
+    } else {
+        reducedCost_.resize(graph_.getNumArcs());
+        for (int a = 0; a < graph_.getNumArcs(); ++a) {
+            reducedCost_[a] = graph_.getReducedCost(a, duals);
+        }
+        const View view{graph_, duals, reducedCost_, graph_.getPathDual(duals)};
+        scheduler_.parallelFor(0, restarts, params_.grain, [this, &view](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r) {
+                runRestart(view, r);
+            }
+        });
+    }
+    restarts_.fetch_add(restarts, std::memory_order_relaxed);
+    const size_t found = collector_.drain(columns);
+    if (found == 0 && fallback_ != nullptr) {
+        ++fallbackCalls_;
+        return fallback_->price(duals, columns);
+    }
+    return -std::numeric_limits<double>::infinity();
+}
+
+GraspStats GraspPricer::getStats() const {
+    GraspStats stats;
+    stats.calls = calls_;
+    stats.restarts = restarts_.load(std::memory_order_relaxed);
+    stats.routesOffered = offered_.load(std::memory_order_relaxed);
+    stats.routesAccepted = collector_.getNumAccepted();
+    stats.improved = improved_.load(std::memory_order_relaxed);
+    stats.fallbackCalls = fallbackCalls_;
+    return stats;
+}
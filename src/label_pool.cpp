@@ -0,0 +1,125 @@
+#include "../include/label_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::atomic<uint64_t> nextSerial{1};
+
+// Last LabelPools the thread asked for and its pool there
+struct LocalPool {
+    uint64_t serial = 0;
+    LabelPool* pool = nullptr;
+};
+thread_local LocalPool tlsPool;
+
+size_t roundUp(size_t bytes, size_t multiple) {
+    return (bytes + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+LabelPool::LabelPool(size_t headerBytes, size_t headerAlignment, int bitsetWords, size_t slabBytes)
+    : bitsetWords_(bitsetWords), slab_(0), next_(0), freeList_(nullptr) {
+    if (headerAlignment == 0 || headerAlignment > alignof(std::max_align_t)
+        || (headerAlignment & (headerAlignment - 1)) != 0) {
+        throw std::runtime_error("Unsupported label alignment " + std::to_string(headerAlignment));
+    }
+    if (bitsetWords < 0) {
+        throw std::runtime_error("Negative label bitset size");
+    }
+    bitsetOffset_ = roundUp(std::max<size_t>(headerBytes, 1), alignof(uint64_t));
+    recordBytes_ = roundUp(bitsetOffset_ + sizeof(uint64_t) * bitsetWords,
+                           std::max({headerAlignment, alignof(uint64_t), alignof(void*)}));
+    recordsPerSlab_ = std::max<size_t>(1, slabBytes / recordBytes_);
+}
+
+void* LabelPool::allocate() {
+    void* record;
+    if (freeList_ != nullptr) {
+        record = freeList_;
+        std::memcpy(&freeList_, record, sizeof(void*));
+    } else {
+        if (slab_ < slabs_.size() && next_ == recordsPerSlab_) {
+            ++slab_;
+            next_ = 0;
+        }
+        if (slab_ == slabs_.size()) {
+            slabs_.emplace_back(new char[recordsPerSlab_ * recordBytes_]);
+            ++stats_.slabs;
+            stats_.reservedBytes += recordsPerSlab_ * recordBytes_;
+        }
+        record = slabs_[slab_].get() + next_++ * recordBytes_;
+    }
+    std::memset(getBitset(record), 0, sizeof(uint64_t) * bitsetWords_);
+    ++stats_.allocations;
+    stats_.peakLabels = std::max(stats_.peakLabels, ++stats_.liveLabels);
+    return record;
+}
+
+void LabelPool::release(void* record) {
+    std::memcpy(record, &freeList_, sizeof(void*));
+    freeList_ = record;
+    ++stats_.releases;
+    --stats_.liveLabels;
+}
+
+void LabelPool::reset() {
+    slab_ = 0;
+    next_ = 0;
+    freeList_ = nullptr;
+    stats_.liveLabels = 0;
+    ++stats_.resets;
+}
+
+LabelPools::LabelPools(size_t headerBytes, size_t headerAlignment, int bitsetWords, size_t slabBytes)
+    : headerBytes_(headerBytes), headerAlignment_(headerAlignment), bitsetWords_(bitsetWords),
+      slabBytes_(slabBytes), serial_(nextSerial.fetch_add(1)) {
+    // Throws on an invalid layout; reserves no slab
+    const LabelPool layout(headerBytes, headerAlignment, bitsetWords, slabBytes);
+}
+
+LabelPool& LabelPools::local() {
+    if (tlsPool.serial == serial_) {
+        return *tlsPool.pool;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<LabelPool>& pool = pools_[std::this_thread::get_id()];
+    if (!pool) {
+        pool.reset(new LabelPool(headerBytes_, headerAlignment_, bitsetWords_, slabBytes_));
+    }
+    tlsPool.serial = serial_;
+    tlsPool.pool = pool.get();
+    return *pool;
+}
+
+void LabelPools::resetAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : pools_) {
+        entry.second->reset();
+    }
+}
+
+LabelPoolStats LabelPools::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LabelPoolStats total;
+    for (const auto& entry : pools_) {
+        const LabelPoolStats& stats = entry.second->getStats();
+        total.slabs += stats.slabs;
+        total.reservedBytes += stats.reservedBytes;
+        total.liveLabels += stats.liveLabels;
+        total.peakLabels += stats.peakLabels;
+        total.allocations += stats.allocations;
+        total.releases += stats.releases;
+        total.resets += stats.resets;
+    }
+    return total;
+}
+
+int LabelPools::getNumPools() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(pools_.size());
+}
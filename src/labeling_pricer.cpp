@@ -0,0 +1,379 @@
+#include "../include/labeling_pricer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+constexpr double kEpsilon = 1e-9;
+
+// Value at x of the piecewise-linear function with breakpoints (x[k], y[k])
+double evaluate(const double* x, const double* y, int size, double at) {
+    if (at <= x[0]) {
+        return y[0];
+    }
+    if (at >= x[size - 1]) {
+        return y[size - 1];
+    }
+    const int k = static_cast<int>(std::upper_bound(x, x + size, at) - x) - 1;
+    return y[k] + (at - x[k]) / (x[k + 1] - x[k]) * (y[k + 1] - y[k]);
+}
+
+// x where the segment (x0, y0) - (x1, y1) reaches level (y0 < level < y1)
+double crossing(double x0, double y0, double x1, double y1, double level) {
+    return x0 + (level - y0) / (y1 - y0) * (x1 - x0);
+}
+
+} // namespace
+
+LabelingPricer::LabelingPricer(const PricingGraph& graph, const LabelingParams& params,
+                               const std::string& name)
+    : graph_(graph), params_(params), name_(name),
+      pool_(sizeof(Label), alignof(Label), params.elementary ? (graph.getNumNodes() + 63) / 64 : 0) {
+    if (!graph.isFinalized()) {
+        throw std::runtime_error("Labeling pricer needs a finalized pricing graph");
+    }
+    if (params.maxColumns < 1) {
+        throw std::runtime_error("Labeling pricer must return at least one column");
+    }
+}
+
+bool LabelingPricer::extend(const Label& label, int arc, double reducedCost, Label& next) {
+    const int head = graph_.getHead(arc);
+    const PricingGraph::Node& node = graph_.node(head);
+    next.load = label.load + node.demand;
+    if (next.load > graph_.getCapacity() + kEpsilon) {
+        return false;
+    }
+    next.node = head;
+    next.arc = arc;
+    next.cost = label.cost + reducedCost;
+    next.dominated = false;
+    next.functionStart = -1;
+    next.functionSize = 0;
+    if (usesFunctions()) {
+        if (!extendFunction(label, arc, next)) {
+            return false;
+        }
+    } else {
+        const double departure = label.time + graph_.node(label.node).service;
+        next.time = std::max(node.earliest, graph_.getArrivalTime(arc, departure));
+        if (next.time > node.latest) {
+            return false;
+        }
+    }
+    if (params_.elementary) {
+        uint64_t* visited = pool_.getBitset(&next);
+        std::memcpy(visited, pool_.getBitset(&label), sizeof(uint64_t) * pool_.getBitsetWords());
+        visited[head / 64] |= uint64_t(1) << (head % 64);
+    }
+    return true;
+}
+
+bool LabelingPricer::extendFunction(const Label& label, int arc, Label& next) {
+    const double service = graph_.node(label.node).service;
+    const PricingGraph::Node& node = graph_.node(graph_.getHead(arc));
+    const double* departures = graph_.getBreakpointDepartures(arc);
+    const int numDepartures = graph_.getNumBreakpoints(arc);
+
+    // 1. Arrival = arc function of (service start + service); the composition gains a
+    // breakpoint wherever the departure passes one of the arc's breakpoints
+    std::vector<std::pair<double, double>> arrival;
+    for (int k = 0; k < label.functionSize; ++k) {
+        const double x = functionX_[label.functionStart + k];
+        const double y = functionY_[label.functionStart + k] + service;
+        arrival.emplace_back(x, graph_.getArrivalTime(arc, y));
+        if (k + 1 == label.functionSize || numDepartures == 0) {
+            continue;
+        }
+        const double nextX = functionX_[label.functionStart + k + 1];
+        const double nextY = functionY_[label.functionStart + k + 1] + service;
+        for (const double* b = std::upper_bound(departures, departures + numDepartures, y);
+             b != departures + numDepartures && *b < nextY; ++b) {
+            arrival.emplace_back(crossing(x, y, nextX, nextY, *b), graph_.getArrivalTime(arc, *b));
+        }
+    }
+
+    // 2. Wait for the time window to open
+    std::vector<std::pair<double, double>> start;
+    for (size_t k = 0; k < arrival.size(); ++k) {
+        if (k > 0 && arrival[k - 1].second < node.earliest && arrival[k].second > node.earliest) {
+            start.emplace_back(crossing(arrival[k - 1].first, arrival[k - 1].second,
+                                        arrival[k].first, arrival[k].second, node.earliest),
+                               node.earliest);
+        }
+        start.emplace_back(arrival[k].first, std::max(arrival[k].second, node.earliest));
+    }
+
+    // 3. Keep the source departures that still meet the window's end (a prefix, as the
+    // function is non-decreasing), dropping repeated and collinear breakpoints
+    if (start.front().second > node.latest) {
+        return false;
+    }
+    next.functionStart = static_cast<int>(functionX_.size());
+    auto append = [&](double x, double y) {
+        const int size = static_cast<int>(functionX_.size()) - next.functionStart;
+        if (size > 0 && x <= functionX_.back() + kEpsilon) {
+            return;
+        }
+        if (size > 1) {
+            const double x0 = functionX_[functionX_.size() - 2];
+            const double y0 = functionY_[functionY_.size() - 2];
+            const double slope0 = (functionY_.back() - y0) / (functionX_.back() - x0);
+            const double slope1 = (y - functionY_.back()) / (x - functionX_.back());
+            if (std::abs(slope0 - slope1) <= kEpsilon) {
+                functionX_.back() = x;
+                functionY_.back() = y;
+                return;
+            }
+        }
+        functionX_.push_back(x);
+        functionY_.push_back(y);
+    };
+    for (size_t k = 0; k < start.size(); ++k) {
+        if (start[k].second <= node.latest) {
+            append(start[k].first, start[k].second);
+            continue;
+        }
+        append(crossing(start[k - 1].first, start[k - 1].second, start[k].first, start[k].second,
+                        node.latest), node.latest);
+        break;
+    }
+    next.functionSize = static_cast<int>(functionX_.size()) - next.functionStart;
+    next.time = functionY_[next.functionStart];
+    stats_.functionPoints += next.functionSize;
+    return true;
+}
+
+bool LabelingPricer::dominates(const Label& a, const Label& b) const {
+    if (a.cost > b.cost || a.load > b.load || a.time > b.time) {
+        return false;
+    }
+    const uint64_t* aVisited = pool_.getBitset(&a);
+    const uint64_t* bVisited = pool_.getBitset(&b);
+    for (int w = 0; w < pool_.getBitsetWords(); ++w) {
+        if ((aVisited[w] & ~bVisited[w]) != 0) {
+            return false;
+        }
+    }
+    if (!usesFunctions()) {
+        return true;
+    }
+
+    // a must be defined on b's whole departure window and never later there; both are
+    // linear between their breakpoints, so comparing at all of them suffices
+    const double* ax = functionX_.data() + a.functionStart;
+    const double* ay = functionY_.data() + a.functionStart;
+    const double* bx = functionX_.data() + b.functionStart;
+    const double* by = functionY_.data() + b.functionStart;
+    const double from = bx[0];
+    const double to = bx[b.functionSize - 1];
+    if (ax[0] > from + kEpsilon || ax[a.functionSize - 1] < to - kEpsilon) {
+        return false;
+    }
+    for (int k = 0; k < b.functionSize; ++k) {
+        if (evaluate(ax, ay, a.functionSize, bx[k]) > by[k] + kEpsilon) {
+            return false;
+        }
+    }
+    for (int k = 0; k < a.functionSize; ++k) {
+        if (ax[k] > from && ax[k] < to && ay[k] > evaluate(bx, by, b.functionSize, ax[k]) + kEpsilon) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LabelingPricer::insert(Label* label) {
+    std::vector<Label*>& bucket = buckets_[label->node];
+    for (const Label* other : bucket) {
+        if (dominates(*other, *label)) {
+            ++stats_.dominated;
+            if (label->functionSize > 0) {
+                functionX_.resize(label->functionStart);
+                functionY_.resize(label->functionStart);
+            }
+            pool_.release(label);
+            return false;
+        }
+    }
+
+    // Labels dominated here are released when they leave the queue (never extended)
+    for (size_t k = 0; k < bucket.size();) {
+        if (dominates(*label, *bucket[k])) {
+            bucket[k]->dominated = true;
+            ++stats_.dominated;
+            bucket[k] = bucket.back();
+            bucket.pop_back();
+        } else {
+            ++k;
+        }
+    }
+    bucket.push_back(label);
+    return true;
+}
+
+double LabelingPricer::getDuration(const Label& label) const {
+    double duration = std::numeric_limits<double>::infinity();
+    for (int k = 0; k < label.functionSize; ++k) {
+        duration = std::min(duration, functionY_[label.functionStart + k]
+                                      - functionX_[label.functionStart + k]);
+    }
+    return duration;
+}
+
+Column LabelingPricer::makeColumn(const Label* label, const std::vector<double>& duals) const {
+    std::vector<std::pair<int, double>> entries;
+    Column column;
+    for (const Label* l = label; l->arc >= 0; l = l->parent) {
+        column.cost += graph_.getCost(l->arc);
+        const int row = graph_.node(l->node).row;
+        if (row >= 0) {
+            entries.emplace_back(row, 1.0);
+        }
+    }
+    if (usesFunctions()) {
+        column.cost += params_.durationCost * getDuration(*label);
+    }
+    if (graph_.getConvexityRow() >= 0) {
+        entries.emplace_back(graph_.getConvexityRow(), 1.0);
+    }
+
+    // Rows in ascending order, repeated visits (non-elementary paths) merged
+    std::sort(entries.begin(), entries.end());
+    column.reducedCost = column.cost;
+    for (const auto& entry : entries) {
+        if (!column.rows.empty() && column.rows.back() == entry.first) {
+            column.values.back() += entry.second;
+        } else {
+            column.rows.push_back(entry.first);
+            column.values.push_back(entry.second);
+        }
+        column.reducedCost -= duals.at(entry.first) * entry.second;
+    }
+    return column;
+}
+
+double LabelingPricer::price(const std::vector<double>& duals, std::vector<Column>& columns) {
+    ++stats_.calls;
+    const int source = graph_.getSource();
+    const int sink = graph_.getSink();
+    pool_.reset();
+    buckets_.assign(graph_.getNumNodes(), std::vector<Label*>());
+    functionX_.clear();
+    functionY_.clear();
+
+    std::vector<double> reducedCost(graph_.getNumArcs());
+    for (int a = 0; a < graph_.getNumArcs(); ++a) {
+        reducedCost[a] = graph_.getReducedCost(a, duals);
+    }
+
+    // Source label; with duration pricing its function is the identity over the window
+    Label* root = static_cast<Label*>(pool_.allocate());
+    root->node = source;
+    root->arc = -1;
+    root->parent = nullptr;
+    root->cost = 0.0;
+    root->load = graph_.node(source).demand;
+    root->time = graph_.node(source).earliest;
+    root->functionStart = -1;
+    root->functionSize = 0;
+    root->dominated = false;
+    if (params_.elementary) {
+        pool_.getBitset(root)[source / 64] |= uint64_t(1) << (source % 64);
+    }
+    if (usesFunctions()) {
+        double latest = graph_.node(source).latest;
+        if (!std::isfinite(latest)) {
+            latest = graph_.node(sink).latest;
+        }
+        if (!std::isfinite(latest)) {
+            throw std::runtime_error("Duration pricing needs a finite source or sink time window");
+        }
+        root->functionStart = 0;
+        functionX_.push_back(root->time);
+        functionY_.push_back(root->time);
+        if (latest > root->time) {
+            functionX_.push_back(latest);
+            functionY_.push_back(latest);
+        }
+        root->functionSize = static_cast<int>(functionX_.size());
+    }
+    insert(root);
+    ++stats_.labels;
+
+    // Label setting by increasing earliest time
+    using Entry = std::pair<double, Label*>;
+    auto later = [](const Entry& a, const Entry& b) { return a.first > b.first; };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(later)> queue(later);
+    queue.push({root->time, root});
+    size_t created = 1;
+    bool truncated = false;
+    while (!queue.empty() && !truncated) {
+        Label* label = queue.top().second;
+        queue.pop();
+        if (label->dominated) {
+            pool_.release(label);
+            continue;
+        }
+        if (label->node == sink) {
+            continue;
+        }
+        const auto range = graph_.outArcs(label->node);
+        for (const int* it = range.first; it != range.second; ++it) {
+            const int a = *it;
+            const int head = graph_.getHead(a);
+            if (!graph_.isActive(a) || head == source) {
+                continue;
+            }
+            if (params_.elementary && (pool_.getBitset(label)[head / 64] >> (head % 64) & 1) != 0) {
+                continue;
+            }
+            if (created >= params_.maxLabels) {
+                truncated = true;
+                break;
+            }
+            Label* next = static_cast<Label*>(pool_.allocate());
+            if (!extend(*label, a, reducedCost[a], *next)) {
+                pool_.release(next);
+                continue;
+            }
+            next->parent = label;
+            ++created;
+            ++stats_.labels;
+            if (insert(next)) {
+                queue.push({next->time, next});
+            }
+        }
+    }
+    if (truncated) {
+        ++stats_.truncated;
+    }
+
+    // Undominated sink labels, most negative reduced cost first
+    const double pathDual = graph_.getPathDual(duals);
+    double minReducedCost = std::numeric_limits<double>::infinity();
+    std::vector<std::pair<double, const Label*>> found;
+    for (const Label* l : buckets_[sink]) {
+        double value = l->cost - pathDual;
+        if (usesFunctions()) {
+            value += params_.durationCost * getDuration(*l);
+        }
+        minReducedCost = std::min(minReducedCost, value);
+        if (value < -params_.tolerance) {
+            found.emplace_back(value, l);
+        }
+    }
+    std::sort(found.begin(), found.end());
+    if (found.size() > static_cast<size_t>(params_.maxColumns)) {
+        found.resize(params_.maxColumns);
+    }
+    for (const auto& entry : found) {
+        columns.push_back(makeColumn(entry.second, duals));
+    }
+    return truncated ? -std::numeric_limits<double>::infinity() : minReducedCost;
+}
@@ -0,0 +1,219 @@
+#include "../include/lagrangian_relaxation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+LagrangianRelaxation::LagrangianRelaxation(ScipSolver& solver,
+                                           const std::vector<ScipConstraint*>& rows,
+                                           const std::vector<ScipVariable*>& columns)
+    : scip_(solver.get()), sense_(1.0), rows_(rows), columns_(columns) {
+
+    if (rows_.empty()) {
+        throw std::runtime_error("Lagrangian relaxation needs at least one row");
+    }
+    for (const auto* row : rows_) {
+        if (row == nullptr) {
+            throw std::runtime_error("Null constraint pointer in Lagrangian relaxation");
+        }
+    }
+    for (const auto* column : columns_) {
+        if (column == nullptr) {
+            throw std::runtime_error("Null variable pointer in Lagrangian relaxation");
+        }
+    }
+    reload();
+}
+
+bool LagrangianRelaxation::isFinite(double value) const {
+    return !SCIPisInfinity(scip_, std::fabs(value));
+}
+
+void LagrangianRelaxation::addColumn(ScipVariable* column) {
+    if (column == nullptr) {
+        throw std::runtime_error("Cannot add null column to Lagrangian relaxation");
+    }
+    columns_.push_back(column);
+    reload();
+}
+
+void LagrangianRelaxation::reload() {
+    sense_ = (SCIPgetObjsense(scip_) == SCIP_OBJSENSE_MAXIMIZE) ? -1.0 : 1.0;
+
+    const size_t numCols = columns_.size();
+    std::unordered_map<SCIP_VAR*, int> columnIndex;
+    columnIndex.reserve(numCols);
+
+    cost_.resize(numCols);
+    lb_.resize(numCols);
+    ub_.resize(numCols);
+    for (size_t j = 0; j < numCols; ++j) {
+        const ScipVariable* column = columns_[j];
+        cost_[j] = sense_ * column->getObjective();
+        lb_[j] = column->getLowerBound();
+        ub_[j] = column->getUpperBound();
+        if (!isFinite(lb_[j]) || !isFinite(ub_[j])) {
+            throw std::runtime_error("Lagrangian relaxation requires finite bounds on column "
+                                     + column->getName());
+        }
+        columnIndex[column->get()] = static_cast<int>(j);
+    }
+
+    // Count nonzeros per column, then fill the column-major arrays
+    lhs_.resize(rows_.size());
+    rhs_.resize(rows_.size());
+    std::vector<int> count(numCols + 1, 0);
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        lhs_[i] = rows_[i]->getLhs();
+        rhs_[i] = rows_[i]->getRhs();
+        for (SCIP_VAR* var : rows_[i]->getRawVariables()) {
+            auto it = columnIndex.find(var);
+            if (it == columnIndex.end()) {
+                throw std::runtime_error("Row " + rows_[i]->getName()
+                                         + " uses a variable that is not a relaxation column");
+            }
+            ++count[it->second + 1];
+        }
+    }
+
+    colStart_.assign(numCols + 1, 0);
+    for (size_t j = 0; j < numCols; ++j) {
+        colStart_[j + 1] = colStart_[j] + count[j + 1];
+    }
+    rowIndex_.resize(colStart_[numCols]);
+    values_.resize(colStart_[numCols]);
+
+    std::vector<int> fill(colStart_.begin(), colStart_.end() - 1);
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        const auto& vars = rows_[i]->getRawVariables();
+        const auto& coeffs = rows_[i]->getCoefficients();
+        for (size_t k = 0; k < vars.size(); ++k) {
+            const int pos = fill[columnIndex[vars[k]]]++;
+            rowIndex_[pos] = static_cast<int>(i);
+            values_[pos] = coeffs[k];
+        }
+    }
+}
+
+void LagrangianRelaxation::projectDuals(std::vector<double>& duals) const {
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        if (!isFinite(lhs_[i])) {
+            duals[i] = std::min(duals[i], 0.0);
+        }
+        if (!isFinite(rhs_[i])) {
+            duals[i] = std::max(duals[i], 0.0);
+        }
+    }
+}
+
+void LagrangianRelaxation::dualBounds(std::vector<double>& lower,
+                                      std::vector<double>& upper) const {
+    const double inf = std::numeric_limits<double>::infinity();
+    lower.assign(rows_.size(), -inf);
+    upper.assign(rows_.size(), inf);
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        if (!isFinite(lhs_[i])) {
+            upper[i] = 0.0;
+        }
+        if (!isFinite(rhs_[i])) {
+            lower[i] = 0.0;
+        }
+    }
+}
+
+double LagrangianRelaxation::evaluate(const std::vector<double>& duals,
+                                      std::vector<double>& x) const {
+    const size_t numCols = columns_.size();
+    x.resize(numCols);
+
+    // Constant part: the side each dual is attached to
+    double value = 0.0;
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        if (duals[i] > 0.0) {
+            value += duals[i] * lhs_[i];
+        } else if (duals[i] < 0.0) {
+            value += duals[i] * rhs_[i];
+        }
+    }
+
+    for (size_t j = 0; j < numCols; ++j) {
+        double reducedCost = cost_[j];
+        for (int k = colStart_[j]; k < colStart_[j + 1]; ++k) {
+            reducedCost -= duals[rowIndex_[k]] * values_[k];
+        }
+        x[j] = (reducedCost < 0.0) ? ub_[j] : lb_[j];
+        value += reducedCost * x[j];
+    }
+    return value;
+}
+
+void LagrangianRelaxation::subgradient(const std::vector<double>& duals,
+                                       const std::vector<double>& x,
+                                       std::vector<double>& g) const {
+    std::vector<double> activity(rows_.size(), 0.0);
+    for (size_t j = 0; j < columns_.size(); ++j) {
+        if (x[j] == 0.0) {
+            continue;
+        }
+        for (int k = colStart_[j]; k < colStart_[j + 1]; ++k) {
+            activity[rowIndex_[k]] += values_[k] * x[j];
+        }
+    }
+
+    g.resize(rows_.size());
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        const bool hasLhs = isFinite(lhs_[i]);
+        const bool hasRhs = isFinite(rhs_[i]);
+        if (duals[i] > 0.0 || (duals[i] == 0.0 && hasLhs && activity[i] < lhs_[i])) {
+            g[i] = lhs_[i] - activity[i];
+        } else if (duals[i] < 0.0 || (duals[i] == 0.0 && hasRhs && activity[i] > rhs_[i])) {
+            g[i] = rhs_[i] - activity[i];
+        } else {
+            g[i] = 0.0;
+        }
+    }
+}
+
+double LagrangianRelaxation::primalObjective(const std::vector<double>& x) const {
+    double value = 0.0;
+    for (size_t j = 0; j < columns_.size(); ++j) {
+        value += cost_[j] * x[j];
+    }
+    return sense_ * value;
+}
+
+double LagrangianRelaxation::maxViolation(const std::vector<double>& x) const {
+    std::vector<double> activity(rows_.size(), 0.0);
+    for (size_t j = 0; j < columns_.size(); ++j) {
+        for (int k = colStart_[j]; k < colStart_[j + 1]; ++k) {
+            activity[rowIndex_[k]] += values_[k] * x[j];
+        }
+    }
+
+    double violation = 0.0;
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        if (isFinite(lhs_[i])) {
+            violation = std::max(violation, lhs_[i] - activity[i]);
+        }
+        if (isFinite(rhs_[i])) {
+            violation = std::max(violation, activity[i] - rhs_[i]);
+        }
+    }
+    return violation;
+}
+
+void LagrangianRelaxation::toModelSense(std::vector<double>& duals) const {
+    for (double& dual : duals) {
+        dual *= sense_;
+    }
+}
+
+std::vector<double> LagrangianRelaxation::fromModelSense(const std::vector<double>& duals) const {
+    if (duals.size() != rows_.size()) {
+        throw std::runtime_error("Dual vector size does not match the number of rows");
+    }
+    std::vector<double> internal(duals);
+    toModelSense(internal);  // sense_ is its own inverse
+    return internal;
+}
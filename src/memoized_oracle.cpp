@@ -0,0 +1,103 @@
+#include "../include/memoized_oracle.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+MemoizedOracle::MemoizedOracle(PricingOracle& inner, const std::vector<double>& maxCoefficients,
+                               const MemoizationParams& params)
+    : inner_(inner), maxCoefficients_(maxCoefficients), uniformCoefficient_(0.0),
+      params_(params), valid_(false), anchorBound_(0.0) {
+    if (maxCoefficients_.empty()) {
+        throw std::runtime_error("Memoized oracle needs coefficient bounds for the master rows");
+    }
+    for (double bound : maxCoefficients_) {
+        if (bound < 0.0 || std::isnan(bound)) {
+            throw std::runtime_error("Coefficient bounds must be non-negative");
+        }
+    }
+}
+
+MemoizedOracle::MemoizedOracle(PricingOracle& inner, double maxCoefficient,
+                               const MemoizationParams& params)
+    : inner_(inner), uniformCoefficient_(maxCoefficient), params_(params),
+      valid_(false), anchorBound_(0.0) {
+    if (maxCoefficient < 0.0 || std::isnan(maxCoefficient)) {
+        throw std::runtime_error("Coefficient bound must be non-negative");
+    }
+}
+
+void MemoizedOracle::invalidate() {
+    valid_ = false;
+    anchorDuals_.clear();
+    cache_.clear();
+}
+
+double MemoizedOracle::drift(const std::vector<double>& duals) const {
+    if (!maxCoefficients_.empty() && maxCoefficients_.size() != duals.size()) {
+        throw std::runtime_error("Coefficient bounds do not match the number of duals");
+    }
+    double total = 0.0;
+    for (size_t i = 0; i < duals.size(); ++i) {
+        const double delta = std::abs(duals[i] - anchorDuals_[i]);
+        total += delta * (maxCoefficients_.empty() ? uniformCoefficient_ : maxCoefficients_[i]);
+    }
+    return total;
+}
+
+double MemoizedOracle::reducedCost(const Column& column, const std::vector<double>& duals) {
+    double rc = column.cost;
+    for (size_t k = 0; k < column.rows.size(); ++k) {
+        rc -= duals[column.rows[k]] * column.values[k];
+    }
+    return rc;
+}
+
+double MemoizedOracle::price(const std::vector<double>& duals, std::vector<Column>& columns) {
+    ++stats_.calls;
+
+    if (valid_ && anchorDuals_.size() == duals.size()) {
+        const double change = drift(duals);
+        const double bound = anchorBound_ - change;
+
+        // No column of this oracle can have become attractive
+        if (bound >= -params_.reducedCostTolerance) {
+            ++stats_.skipped;
+            return bound;
+        }
+
+        // Small move: offer the cached candidates that still price out
+        if (change <= params_.reuseDrift) {
+            size_t offered = 0;
+            for (const Column& cached : cache_) {
+                const double rc = reducedCost(cached, duals);
+                if (rc < -params_.reducedCostTolerance) {
+                    columns.push_back(cached);
+                    columns.back().reducedCost = rc;
+                    ++offered;
+                }
+            }
+            if (offered > 0) {
+                ++stats_.reused;
+                return bound;
+            }
+        }
+    }
+
+    // Real call; its columns become the new cache
+    ++stats_.solved;
+    const size_t first = columns.size();
+    const double bound = inner_.price(duals, columns);
+
+    valid_ = std::isfinite(bound);
+    anchorDuals_ = duals;
+    anchorBound_ = bound;
+    cache_.assign(columns.begin() + first, columns.end());
+    if (static_cast<int>(cache_.size()) > params_.maxCachedColumns) {
+        std::partial_sort(cache_.begin(), cache_.begin() + params_.maxCachedColumns, cache_.end(),
+                          [](const Column& a, const Column& b) {
+                              return a.reducedCost < b.reducedCost;
+                          });
+        cache_.resize(params_.maxCachedColumns);
+    }
+    return bound;
+}
@@ -0,0 +1,300 @@
+#include "../include/mpi_pricing.hpp"
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Per subproblem: int32 id, int32 failed, double bound, int32 columns; per column:
+// int32 count, double cost, double reduced cost, double upper bound, rows, values
+template <typename T>
+void append(std::vector<char>& buffer, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T read(const char*& cursor) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+class WaitTimer {
+private:
+    double& total_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    explicit WaitTimer(double& total) : total_(total), start_(std::chrono::steady_clock::now()) {}
+    ~WaitTimer() {
+        total_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+};
+
+} // namespace
+
+double MpiPricing::Proxy::price(const std::vector<double>& duals, std::vector<Column>& columns) {
+    return owner_.take(subproblem_, duals, columns);
+}
+
+double MpiPricing::Proxy::getMultiplicity() const {
+    return owner_.multiplicities_[subproblem_];
+}
+
+MpiPricing::MpiPricing(MPI_Comm comm, int numRows, int numSubproblems,
+                       const std::function<std::unique_ptr<PricingOracle>(int)>& factory,
+                       const std::vector<double>& multiplicities,
+                       const MpiPricingParams& params)
+    : comm_(comm), rank_(0), size_(1), numRows_(numRows), numSubproblems_(numSubproblems),
+      multiplicities_(multiplicities), params_(params), stopped_(false) {
+    if (numRows_ <= 0 || numSubproblems_ <= 0) {
+        throw std::runtime_error("MPI pricing needs rows and at least one subproblem");
+    }
+    if (multiplicities_.empty()) {
+        multiplicities_.assign(numSubproblems_, std::numeric_limits<double>::infinity());
+    } else if (static_cast<int>(multiplicities_.size()) != numSubproblems_) {
+        throw std::runtime_error("One multiplicity per subproblem expected");
+    }
+    if (params_.batches < 1) {
+        params_.batches = 1;
+    }
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &size_);
+
+    for (int k = 0; k < numSubproblems_; ++k) {
+        if (ownerOf(k) == rank_) {
+            owned_.push_back(k);
+            oracles_.push_back(factory(k));
+            if (!oracles_.back()) {
+                throw std::runtime_error("MPI pricing factory returned no oracle for subproblem "
+                                         + std::to_string(k));
+            }
+        }
+    }
+    if (rank_ == 0) {
+        results_.resize(numSubproblems_);
+        for (int k = 0; k < numSubproblems_; ++k) {
+            proxies_.push_back(std::make_unique<Proxy>(*this, k));
+        }
+    }
+}
+
+MpiPricing::~MpiPricing() {
+    try {
+        shutdown();
+    } catch (...) {
+        // Never throw from the destructor
+    }
+}
+
+int MpiPricing::ownerOf(int subproblem) const {
+    return size_ == 1 ? 0 : 1 + subproblem % (size_ - 1);
+}
+
+// Blocking: rank 0 prices nothing itself, so there is no work to overlap with
+void MpiPricing::broadcast(std::vector<double>& message) {
+    MPI_Bcast(message.data(), numRows_ + 1, MPI_DOUBLE, 0, comm_);
+}
+
+std::vector<char> MpiPricing::priceBatch(const std::vector<double>& duals, int batch) {
+    std::vector<char> buffer;
+    std::vector<Column> columns;
+    for (size_t i = batch; i < owned_.size(); i += params_.batches) {
+        columns.clear();
+        double bound = -std::numeric_limits<double>::infinity();
+        int32_t failed = 0;
+        try {
+            bound = oracles_[i]->price(duals, columns);
+        } catch (const std::exception&) {
+            failed = 1;
+            columns.clear();
+        }
+
+        append<int32_t>(buffer, owned_[i]);
+        append<int32_t>(buffer, failed);
+        append<double>(buffer, bound);
+        append<int32_t>(buffer, static_cast<int32_t>(columns.size()));
+        for (const Column& column : columns) {
+            append<int32_t>(buffer, static_cast<int32_t>(column.rows.size()));
+            append<double>(buffer, column.cost);
+            append<double>(buffer, column.reducedCost);
+            append<double>(buffer, column.upperBound);
+            for (int row : column.rows) {
+                append<int32_t>(buffer, row);
+            }
+            for (double value : column.values) {
+                append<double>(buffer, value);
+            }
+        }
+    }
+    return buffer;
+}
+
+int MpiPricing::unpack(const char* data, size_t bytes) {
+    int failedSubproblem = -1;
+    const char* cursor = data;
+    const char* end = data + bytes;
+    while (cursor < end) {
+        const int32_t subproblem = read<int32_t>(cursor);
+        const int32_t failed = read<int32_t>(cursor);
+        Result& result = results_.at(subproblem);
+        result.bound = read<double>(cursor);
+        const int32_t numColumns = read<int32_t>(cursor);
+        if (failed && failedSubproblem < 0) {
+            failedSubproblem = subproblem;
+        }
+        for (int32_t c = 0; c < numColumns; ++c) {
+            Column column;
+            const int32_t count = read<int32_t>(cursor);
+            column.cost = read<double>(cursor);
+            column.reducedCost = read<double>(cursor);
+            column.upperBound = read<double>(cursor);
+            column.rows.resize(count);
+            column.values.resize(count);
+            for (int32_t k = 0; k < count; ++k) {
+                column.rows[k] = read<int32_t>(cursor);
+            }
+            for (int32_t k = 0; k < count; ++k) {
+                column.values[k] = read<double>(cursor);
+            }
+            result.columns.push_back(std::move(column));
+            ++stats_.columnsReceived;
+        }
+    }
+    return failedSubproblem;
+}
+
+void MpiPricing::runRound(const std::vector<double>& duals) {
+    const int batches = params_.batches;
+    std::vector<std::vector<char>> sendBuffers(batches);
+    std::vector<int> sendSizes(batches, 0);
+    std::vector<MPI_Request> sizeRequests(batches, MPI_REQUEST_NULL);
+    std::vector<MPI_Request> dataRequests(batches, MPI_REQUEST_NULL);
+    std::vector<std::vector<int>> recvSizes(batches, std::vector<int>(rank_ == 0 ? size_ : 0));
+    std::vector<std::vector<int>> displacements(batches, std::vector<int>(rank_ == 0 ? size_ : 0));
+    std::vector<std::vector<char>> recvBuffers(batches);
+    int failedSubproblem = -1;
+
+    auto finishBatch = [&](int batch) {
+        {
+            WaitTimer timer(stats_.waitTime);
+            MPI_Wait(&dataRequests[batch], MPI_STATUS_IGNORE);
+        }
+        stats_.bytesReceived += static_cast<long>(recvBuffers[batch].size());
+        const int failed = unpack(recvBuffers[batch].data(), recvBuffers[batch].size());
+        if (failedSubproblem < 0) {
+            failedSubproblem = failed;
+        }
+    };
+
+    // Collectives are posted in the same order on every rank: size gather, data gather
+    for (int b = 0; b < batches; ++b) {
+        sendBuffers[b] = priceBatch(duals, b);
+        sendSizes[b] = static_cast<int>(sendBuffers[b].size());
+        MPI_Igather(&sendSizes[b], 1, MPI_INT, rank_ == 0 ? recvSizes[b].data() : nullptr,
+                    1, MPI_INT, 0, comm_, &sizeRequests[b]);
+
+        if (rank_ != 0) {
+            MPI_Igatherv(sendBuffers[b].data(), sendSizes[b], MPI_BYTE,
+                         nullptr, nullptr, nullptr, MPI_BYTE, 0, comm_, &dataRequests[b]);
+            continue;
+        }
+
+        {
+            WaitTimer timer(stats_.waitTime);
+            MPI_Wait(&sizeRequests[b], MPI_STATUS_IGNORE);
+        }
+        int total = 0;
+        for (int r = 0; r < size_; ++r) {
+            displacements[b][r] = total;
+            total += recvSizes[b][r];
+        }
+        recvBuffers[b].resize(total);
+        MPI_Igatherv(sendBuffers[b].data(), sendSizes[b], MPI_BYTE,
+                     recvBuffers[b].data(), recvSizes[b].data(), displacements[b].data(),
+                     MPI_BYTE, 0, comm_, &dataRequests[b]);
+
+        // Unpack the previous batch while this one is in flight
+        if (b > 0) {
+            finishBatch(b - 1);
+        }
+    }
+
+    if (rank_ != 0) {
+        MPI_Waitall(batches, sizeRequests.data(), MPI_STATUSES_IGNORE);
+        MPI_Waitall(batches, dataRequests.data(), MPI_STATUSES_IGNORE);
+        return;
+    }
+    finishBatch(batches - 1);
+
+    // Only now: every collective of the round has completed on all ranks
+    if (failedSubproblem >= 0) {
+        throw std::runtime_error("Pricing of subproblem " + std::to_string(failedSubproblem)
+                                 + " failed on rank " + std::to_string(ownerOf(failedSubproblem)));
+    }
+}
+
+void MpiPricing::serve() {
+    if (rank_ == 0) {
+        throw std::runtime_error("serve() is for worker ranks; rank 0 drives the rounds");
+    }
+    std::vector<double> message(numRows_ + 1);
+    std::vector<double> duals(numRows_);
+    for (;;) {
+        broadcast(message);
+        if (message[0] == 0.0) {
+            break;
+        }
+        std::copy(message.begin() + 1, message.end(), duals.begin());
+        runRound(duals);
+    }
+    stopped_ = true;
+}
+
+void MpiPricing::shutdown() {
+    if (rank_ != 0 || stopped_) {
+        return;
+    }
+    stopped_ = true;
+    if (size_ > 1) {
+        std::vector<double> message(numRows_ + 1, 0.0);
+        broadcast(message);
+    }
+}
+
+double MpiPricing::take(int subproblem, const std::vector<double>& duals,
+                        std::vector<Column>& columns) {
+    if (rank_ != 0 || stopped_) {
+        throw std::runtime_error("MPI pricing oracles are only usable on rank 0 before shutdown");
+    }
+    if (static_cast<int>(duals.size()) != numRows_) {
+        throw std::runtime_error("MPI pricing expects " + std::to_string(numRows_) + " duals, got "
+                                 + std::to_string(duals.size()));
+    }
+
+    Result& result = results_[subproblem];
+    if (result.taken || duals != roundDuals_) {
+        roundDuals_ = duals;
+        for (Result& r : results_) {
+            r.columns.clear();
+        }
+        std::vector<double> message(numRows_ + 1);
+        message[0] = 1.0;
+        std::copy(duals.begin(), duals.end(), message.begin() + 1);
+        {
+            WaitTimer timer(stats_.waitTime);
+            broadcast(message);
+        }
+        runRound(duals);
+        ++stats_.rounds;
+        for (Result& r : results_) {
+            r.taken = false;
+        }
+    }
+    columns.insert(columns.end(), result.columns.begin(), result.columns.end());
+    result.taken = true;
+    return result.bound;
+}
@@ -0,0 +1,140 @@
+#include "../include/numa_topology.hpp"
+#include <algorithm>
+#include <cctype>
+#include <dirent.h>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const char* kNodeDirectory = "/sys/devices/system/node";
+
+} // namespace
+
+NumaTopology::NumaTopology(const std::vector<std::vector<int>>& nodeCpus)
+    : nodeCpus_(nodeCpus) {
+    nodeCpus_.erase(std::remove_if(nodeCpus_.begin(), nodeCpus_.end(),
+                                   [](const std::vector<int>& cpus) { return cpus.empty(); }),
+                    nodeCpus_.end());
+    if (nodeCpus_.empty()) {
+        throw std::runtime_error("NUMA topology needs at least one CPU");
+    }
+    for (size_t node = 0; node < nodeCpus_.size(); ++node) {
+        auto& cpus = nodeCpus_[node];
+        std::sort(cpus.begin(), cpus.end());
+        for (int cpu : cpus) {
+            if (cpu < 0) {
+                throw std::runtime_error("Negative CPU id in NUMA topology");
+            }
+            if (cpu >= static_cast<int>(cpuNode_.size())) {
+                cpuNode_.resize(cpu + 1, -1);
+            }
+            cpuNode_[cpu] = static_cast<int>(node);
+        }
+    }
+}
+
+NumaTopology NumaTopology::detect() {
+    std::vector<std::pair<int, std::vector<int>>> nodes;
+    if (DIR* dir = opendir(kNodeDirectory)) {
+        while (dirent* entry = readdir(dir)) {
+            const std::string name = entry->d_name;
+            if (name.size() <= 4 || name.compare(0, 4, "node") != 0
+                || !std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+                continue;
+            }
+            std::ifstream file(std::string(kNodeDirectory) + "/" + name + "/cpulist");
+            std::string list;
+            if (file && std::getline(file, list)) {
+                nodes.emplace_back(std::stoi(name.substr(4)), parseCpuList(list));
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(nodes.begin(), nodes.end());
+
+    std::vector<std::vector<int>> nodeCpus;
+    for (auto& node : nodes) {
+        if (!node.second.empty()) {
+            nodeCpus.push_back(std::move(node.second));
+        }
+    }
+    if (nodeCpus.empty()) {
+        const int cpus = std::max(1u, std::thread::hardware_concurrency());
+        nodeCpus.emplace_back();
+        for (int cpu = 0; cpu < cpus; ++cpu) {
+            nodeCpus.back().push_back(cpu);
+        }
+    }
+    return NumaTopology(nodeCpus);
+}
+
+int NumaTopology::getNumCpus() const {
+    int total = 0;
+    for (const auto& cpus : nodeCpus_) {
+        total += static_cast<int>(cpus.size());
+    }
+    return total;
+}
+
+int NumaTopology::getNodeOfCpu(int cpu) const {
+    if (cpu < 0 || cpu >= static_cast<int>(cpuNode_.size())) {
+        return -1;
+    }
+    return cpuNode_[cpu];
+}
+
+int NumaTopology::getCurrentNode() const {
+    const int node = getNodeOfCpu(sched_getcpu());
+    return node >= 0 ? node : 0;
+}
+
+int NumaTopology::getCpuForWorker(int worker) const {
+    int slot = worker % getNumCpus();
+    for (const auto& cpus : nodeCpus_) {
+        if (slot < static_cast<int>(cpus.size())) {
+            return cpus[slot];
+        }
+        slot -= static_cast<int>(cpus.size());
+    }
+    return nodeCpus_.front().front();
+}
+
+std::vector<int> NumaTopology::parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty()) {
+            continue;
+        }
+        const size_t dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+bool pinCurrentThreadToCpu(int cpu) {
+    return pinCurrentThreadToCpus({cpu});
+}
+
+bool pinCurrentThreadToCpus(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return !cpus.empty() && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
@@ -0,0 +1,290 @@
+#include "../include/pricing_graph.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Labels created by one elimination pass before it gives up (no arc is removed then)
+constexpr size_t kMaxLabels = size_t(1) << 22;
+
+// (reduced cost, time) resource label of the bounding relaxation
+struct TimeLabel {
+    double cost;
+    double time;
+    int node;
+};
+
+} // namespace
+
+PricingGraph::PricingGraph(int numNodes, int source, int sink)
+    : nodes_(numNodes), source_(source), sink_(sink), convexityRow_(-1),
+      capacity_(std::numeric_limits<double>::infinity()), finalized_(false) {
+    if (numNodes < 2) {
+        throw std::runtime_error("Pricing graph needs at least a source and a sink");
+    }
+    if (source < 0 || source >= numNodes || sink < 0 || sink >= numNodes || source == sink) {
+        throw std::runtime_error("Invalid source or sink node in pricing graph");
+    }
+}
+
+int PricingGraph::addArc(int tail, int head, double cost, double travelTime) {
+    if (finalized_) {
+        throw std::runtime_error("Cannot add arcs to a finalized pricing graph");
+    }
+    if (tail < 0 || tail >= getNumNodes() || head < 0 || head >= getNumNodes()) {
+        throw std::runtime_error("Arc references unknown node (" + std::to_string(tail)
+                                 + ", " + std::to_string(head) + ")");
+    }
+    tail_.push_back(tail);
+    head_.push_back(head);
+    cost_.push_back(cost);
+    travelTime_.push_back(travelTime);
+    active_.push_back(1);
+    return getNumArcs() - 1;
+}
+
+void PricingGraph::setTravelTimeFunction(int arc, const std::vector<double>& departures,
+                                         const std::vector<double>& durations) {
+    if (arc < 0 || arc >= getNumArcs()) {
+        throw std::runtime_error("Unknown arc " + std::to_string(arc));
+    }
+    if (departures.empty() || departures.size() != durations.size()) {
+        throw std::runtime_error("Travel time function of arc " + std::to_string(arc)
+                                 + " needs matching, non-empty breakpoints");
+    }
+    for (size_t k = 0; k < departures.size(); ++k) {
+        if (!std::isfinite(departures[k]) || !std::isfinite(durations[k]) || durations[k] < 0.0) {
+            throw std::runtime_error("Invalid travel time breakpoint on arc " + std::to_string(arc));
+        }
+        if (k == 0) {
+            continue;
+        }
+        if (departures[k] <= departures[k - 1]) {
+            throw std::runtime_error("Travel time departures of arc " + std::to_string(arc)
+                                     + " must be strictly ascending");
+        }
+        // FIFO: arrival departure + duration must not decrease
+        if (departures[k] + durations[k] < departures[k - 1] + durations[k - 1] - 1e-9) {
+            throw std::runtime_error("Travel time function of arc " + std::to_string(arc)
+                                     + " violates FIFO");
+        }
+    }
+    ttfStart_.resize(getNumArcs(), -1);
+    ttfSize_.resize(getNumArcs(), 0);
+    ttfStart_[arc] = static_cast<int>(ttfDeparture_.size());
+    ttfSize_[arc] = static_cast<int>(departures.size());
+    ttfDeparture_.insert(ttfDeparture_.end(), departures.begin(), departures.end());
+    ttfDuration_.insert(ttfDuration_.end(), durations.begin(), durations.end());
+    travelTime_[arc] = *std::min_element(durations.begin(), durations.end());
+}
+
+double PricingGraph::getArrivalTime(int arc, double departure) const {
+    if (!isTimeDependent(arc)) {
+        return departure + travelTime_[arc];
+    }
+    const double* x = ttfDeparture_.data() + ttfStart_[arc];
+    const double* y = ttfDuration_.data() + ttfStart_[arc];
+    const int size = ttfSize_[arc];
+    if (departure <= x[0]) {
+        return departure + y[0];
+    }
+    if (departure >= x[size - 1]) {
+        return departure + y[size - 1];
+    }
+    const int k = static_cast<int>(std::upper_bound(x, x + size, departure) - x) - 1;
+    const double share = (departure - x[k]) / (x[k + 1] - x[k]);
+    return departure + y[k] + share * (y[k + 1] - y[k]);
+}
+
+void PricingGraph::finalize() {
+    const int n = getNumNodes();
+    const int m = getNumArcs();
+
+    // Counting sort of the arc ids by tail and by head
+    outStart_.assign(n + 1, 0);
+    inStart_.assign(n + 1, 0);
+    for (int a = 0; a < m; ++a) {
+        ++outStart_[tail_[a] + 1];
+        ++inStart_[head_[a] + 1];
+    }
+    for (int i = 0; i < n; ++i) {
+        outStart_[i + 1] += outStart_[i];
+        inStart_[i + 1] += inStart_[i];
+    }
+    outArcs_.resize(m);
+    inArcs_.resize(m);
+    std::vector<int> outPos(outStart_.begin(), outStart_.end() - 1);
+    std::vector<int> inPos(inStart_.begin(), inStart_.end() - 1);
+    for (int a = 0; a < m; ++a) {
+        outArcs_[outPos[tail_[a]]++] = a;
+        inArcs_[inPos[head_[a]]++] = a;
+    }
+    finalized_ = true;
+}
+
+int PricingGraph::getNumActiveArcs() const {
+    return static_cast<int>(std::count(active_.begin(), active_.end(), 1));
+}
+
+double PricingGraph::getReducedCost(int arc, const std::vector<double>& duals) const {
+    const int row = nodes_[head_[arc]].row;
+    return row >= 0 ? cost_[arc] - duals.at(row) : cost_[arc];
+}
+
+double PricingGraph::getPathDual(const std::vector<double>& duals) const {
+    return convexityRow_ >= 0 ? duals.at(convexityRow_) : 0.0;
+}
+
+std::vector<int> PricingGraph::eliminateArcs(const std::vector<double>& duals,
+                                             double masterObjective,
+                                             double multiplicity, double incumbent) {
+    if (!finalized_) {
+        throw std::runtime_error("Pricing graph must be finalized before arc elimination");
+    }
+    std::vector<int> eliminated;
+    if (!std::isfinite(incumbent) || !std::isfinite(masterObjective)) {
+        return eliminated;
+    }
+
+    const int n = getNumNodes();
+    const int m = getNumArcs();
+    std::vector<double> reducedCost(m);
+    for (int a = 0; a < m; ++a) {
+        if (active_[a] && nodes_[tail_[a]].service + travelTime_[a] <= 0.0) {
+            throw std::runtime_error("Arc elimination needs positive arc durations (arc "
+                                     + std::to_string(a) + ")");
+        }
+        reducedCost[a] = getReducedCost(a, duals);
+    }
+
+    // Forward labels: earliest service start at each node. Popped by increasing time, so
+    // every front is appended in increasing time with strictly decreasing cost.
+    auto later = [](const TimeLabel& a, const TimeLabel& b) { return a.time > b.time; };
+    std::priority_queue<TimeLabel, std::vector<TimeLabel>, decltype(later)> forwardQueue(later);
+    std::vector<std::vector<std::pair<double, double>>> forward(n);   // (time, cost)
+    forwardQueue.push({-getPathDual(duals), nodes_[source_].earliest, source_});
+    size_t labels = 1;
+    while (!forwardQueue.empty()) {
+        const TimeLabel label = forwardQueue.top();
+        forwardQueue.pop();
+        auto& front = forward[label.node];
+        if (!front.empty() && front.back().second <= label.cost) {
+            continue;
+        }
+        front.emplace_back(label.time, label.cost);
+        if (label.node == sink_) {
+            continue;
+        }
+        const Node& tail = nodes_[label.node];
+        for (int k = outStart_[label.node]; k < outStart_[label.node + 1]; ++k) {
+            const int a = outArcs_[k];
+            if (!active_[a] || head_[a] == source_) {
+                continue;
+            }
+            const Node& head = nodes_[head_[a]];
+            const double time = std::max(head.earliest, label.time + tail.service + travelTime_[a]);
+            const double cost = label.cost + reducedCost[a];
+            if (time > head.latest) {
+                continue;
+            }
+            const auto& headFront = forward[head_[a]];
+            if (!headFront.empty() && headFront.back().second <= cost) {
+                continue;
+            }
+            if (++labels > kMaxLabels) {
+                return eliminated;
+            }
+            forwardQueue.push({cost, time, head_[a]});
+        }
+    }
+
+    // Backward labels: latest service start at each node that still reaches the sink.
+    // Popped by decreasing time, fronts are appended in decreasing time and cost.
+    auto earlier = [](const TimeLabel& a, const TimeLabel& b) { return a.time < b.time; };
+    std::priority_queue<TimeLabel, std::vector<TimeLabel>, decltype(earlier)> backwardQueue(earlier);
+    std::vector<std::vector<std::pair<double, double>>> backward(n);  // (time, cost)
+    backwardQueue.push({0.0, nodes_[sink_].latest, sink_});
+    while (!backwardQueue.empty()) {
+        const TimeLabel label = backwardQueue.top();
+        backwardQueue.pop();
+        auto& front = backward[label.node];
+        if (!front.empty() && front.back().second <= label.cost) {
+            continue;
+        }
+        front.emplace_back(label.time, label.cost);
+        if (label.node == source_) {
+            continue;
+        }
+        for (int k = inStart_[label.node]; k < inStart_[label.node + 1]; ++k) {
+            const int a = inArcs_[k];
+            if (!active_[a] || tail_[a] == sink_) {
+                continue;
+            }
+            const Node& tail = nodes_[tail_[a]];
+            const double time = std::min(tail.latest, label.time - travelTime_[a] - tail.service);
+            const double cost = label.cost + reducedCost[a];
+            if (time < tail.earliest) {
+                continue;
+            }
+            const auto& tailFront = backward[tail_[a]];
+            if (!tailFront.empty() && tailFront.back().second <= cost) {
+                continue;
+            }
+            if (++labels > kMaxLabels) {
+                return eliminated;
+            }
+            backwardQueue.push({cost, time, tail_[a]});
+        }
+    }
+
+    // Other paths of a solution each cost at least the relaxed minimum reduced cost
+    const double minReducedCost = forward[sink_].empty()
+        ? std::numeric_limits<double>::infinity()
+        : forward[sink_].back().second;
+    double others = 0.0;
+    if (minReducedCost < 0.0 && multiplicity > 1.0) {
+        others = (multiplicity - 1.0) * minReducedCost;
+    }
+    if (!std::isfinite(others)) {
+        return eliminated;
+    }
+    const double threshold = incumbent - masterObjective - others
+        + 1e-6 * std::max(1.0, std::abs(incumbent));
+
+    for (int a = 0; a < m; ++a) {
+        if (!active_[a]) {
+            continue;
+        }
+        const auto& tailFront = forward[tail_[a]];
+        const auto& headFront = backward[head_[a]];
+        const Node& tail = nodes_[tail_[a]];
+        const Node& head = nodes_[head_[a]];
+
+        // Cheapest forward/backward combination through the arc; the backward labels with
+        // time >= arrival form a prefix of headFront whose last entry is the cheapest
+        double best = std::numeric_limits<double>::infinity();
+        size_t prefix = headFront.size();
+        for (const auto& label : tailFront) {
+            const double arrival = std::max(head.earliest, label.first + tail.service + travelTime_[a]);
+            if (arrival > head.latest) {
+                break;
+            }
+            while (prefix > 0 && headFront[prefix - 1].first < arrival) {
+                --prefix;
+            }
+            if (prefix == 0) {
+                break;
+            }
+            best = std::min(best, label.second + reducedCost[a] + headFront[prefix - 1].second);
+        }
+        if (best > threshold) {
+            active_[a] = 0;
+            eliminated.push_back(a);
+        }
+    }
+    return eliminated;
+}
@@ -0,0 +1,356 @@
+#include "../include/pricing_recorder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+const char kMagic[8] = {'C', 'G', 'P', 'R', 'L', 'O', 'G', '\0'};
+constexpr uint32_t kVersion = 1;
+
+enum RecordType : uint8_t {
+    kOracleRecord = 1,          // Name of the next oracle index
+    kStateRecord = 2,           // Branching state of the following calls
+    kCallRecord = 3
+};
+
+enum DualEncoding : uint8_t {
+    kDenseDuals = 0,
+    kSparseDuals = 1            // (index, value) of the entries that changed
+};
+
+void putBytes(std::string& out, const void* data, size_t bytes) {
+    out.append(static_cast<const char*>(data), bytes);
+}
+
+void putU8(std::string& out, uint8_t value) { putBytes(out, &value, sizeof(value)); }
+void putU32(std::string& out, uint32_t value) { putBytes(out, &value, sizeof(value)); }
+void putI32(std::string& out, int32_t value) { putBytes(out, &value, sizeof(value)); }
+void putI64(std::string& out, int64_t value) { putBytes(out, &value, sizeof(value)); }
+void putF64(std::string& out, double value) { putBytes(out, &value, sizeof(value)); }
+
+void putString(std::string& out, const std::string& value) {
+    putU32(out, static_cast<uint32_t>(value.size()));
+    out += value;
+}
+
+// Bounds-checked cursor over a loaded log
+class LogReader {
+private:
+    const std::string& data_;
+    size_t pos_;
+
+public:
+    explicit LogReader(const std::string& data) : data_(data), pos_(0) {}
+
+    bool atEnd() const { return pos_ == data_.size(); }
+
+    void getBytes(void* target, size_t bytes) {
+        if (data_.size() - pos_ < bytes) {
+            throw std::runtime_error("Truncated pricing log");
+        }
+        std::memcpy(target, data_.data() + pos_, bytes);
+        pos_ += bytes;
+    }
+
+    uint8_t getU8() { uint8_t v; getBytes(&v, sizeof(v)); return v; }
+    uint32_t getU32() { uint32_t v; getBytes(&v, sizeof(v)); return v; }
+    int32_t getI32() { int32_t v; getBytes(&v, sizeof(v)); return v; }
+    int64_t getI64() { int64_t v; getBytes(&v, sizeof(v)); return v; }
+    double getF64() { double v; getBytes(&v, sizeof(v)); return v; }
+
+    std::string getString() {
+        const uint32_t size = getU32();
+        if (data_.size() - pos_ < size) {
+            throw std::runtime_error("Truncated pricing log");
+        }
+        std::string value = data_.substr(pos_, size);
+        pos_ += size;
+        return value;
+    }
+};
+
+double bestReducedCost(const std::vector<Column>& columns) {
+    double best = 0.0;
+    for (const Column& column : columns) {
+        best = std::min(best, column.reducedCost);
+    }
+    return best;
+}
+
+bool differs(double a, double b, double tolerance) {
+    if (std::isinf(a) || std::isinf(b)) {
+        return a != b;
+    }
+    return std::abs(a - b) > tolerance * (1.0 + std::abs(a));
+}
+
+} // namespace
+
+PricingRecorder::PricingRecorder(const std::string& path)
+    : out_(path, std::ios::binary | std::ios::trunc), stateWritten_(false) {
+    if (!out_) {
+        throw std::runtime_error("Cannot open pricing log '" + path + "'");
+    }
+    putBytes(buffer_, kMagic, sizeof(kMagic));
+    putU32(buffer_, kVersion);
+    writeBuffer();
+}
+
+PricingRecorder::~PricingRecorder() {
+    out_.flush();
+}
+
+void PricingRecorder::writeBuffer() {
+    if (!out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()))) {
+        throw std::runtime_error("Cannot write pricing log");
+    }
+    stats_.bytes += buffer_.size();
+    buffer_.clear();
+}
+
+void PricingRecorder::setBranchingState(const PricingBranchingState& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_ = state;
+    stateWritten_ = false;
+}
+
+void PricingRecorder::record(const std::string& oracle, const std::vector<double>& duals,
+                             const Column* columns, size_t numColumns, double bound,
+                             double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto known = oracles_.find(oracle);
+    if (known == oracles_.end()) {
+        known = oracles_.emplace(oracle, static_cast<int>(oracles_.size())).first;
+        putU8(buffer_, kOracleRecord);
+        putString(buffer_, oracle);
+    }
+
+    // The first call always writes the (possibly default) root state
+    if (!stateWritten_) {
+        putU8(buffer_, kStateRecord);
+        putI64(buffer_, state_.node);
+        putU32(buffer_, static_cast<uint32_t>(state_.bounds.size()));
+        for (const RecordedBound& entry : state_.bounds) {
+            putI32(buffer_, entry.index);
+            putF64(buffer_, entry.lower);
+            putF64(buffer_, entry.upper);
+        }
+        stateWritten_ = true;
+    }
+
+    putU8(buffer_, kCallRecord);
+    putU32(buffer_, static_cast<uint32_t>(known->second));
+    putF64(buffer_, bound);
+    putF64(buffer_, seconds);
+    putU32(buffer_, static_cast<uint32_t>(duals.size()));
+
+    // Exact bit comparison, so replayed duals are identical to the recorded ones
+    size_t changed = duals.size();
+    if (lastDuals_.size() == duals.size()) {
+        changed = 0;
+        for (size_t i = 0; i < duals.size(); ++i) {
+            changed += std::memcmp(&duals[i], &lastDuals_[i], sizeof(double)) != 0;
+        }
+    }
+    if (changed * (sizeof(uint32_t) + sizeof(double)) + sizeof(uint32_t)
+        < duals.size() * sizeof(double)) {
+        putU8(buffer_, kSparseDuals);
+        putU32(buffer_, static_cast<uint32_t>(changed));
+        for (size_t i = 0; i < duals.size(); ++i) {
+            if (std::memcmp(&duals[i], &lastDuals_[i], sizeof(double)) != 0) {
+                putU32(buffer_, static_cast<uint32_t>(i));
+                putF64(buffer_, duals[i]);
+            }
+        }
+        ++stats_.sparseDuals;
+    } else {
+        putU8(buffer_, kDenseDuals);
+        putBytes(buffer_, duals.data(), duals.size() * sizeof(double));
+    }
+    lastDuals_ = duals;
+
+    putU32(buffer_, static_cast<uint32_t>(numColumns));
+    for (size_t c = 0; c < numColumns; ++c) {
+        const Column& column = columns[c];
+        putF64(buffer_, column.cost);
+        putF64(buffer_, column.reducedCost);
+        putF64(buffer_, column.upperBound);
+        putU32(buffer_, static_cast<uint32_t>(column.rows.size()));
+        for (int row : column.rows) {
+            putI32(buffer_, row);
+        }
+        putBytes(buffer_, column.values.data(), column.values.size() * sizeof(double));
+        putString(buffer_, column.name);
+    }
+    writeBuffer();
+
+    ++stats_.calls;
+    stats_.columns += numColumns;
+}
+
+void PricingRecorder::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out_.flush();
+}
+
+PricingRecorderStats PricingRecorder::getStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+double RecordingOracle::price(const std::vector<double>& duals, std::vector<Column>& columns) {
+    const size_t first = columns.size();
+    const auto start = std::chrono::steady_clock::now();
+    const double bound = inner_.price(duals, columns);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    recorder_.record(inner_.getName(), duals, columns.data() + first, columns.size() - first,
+                     bound, seconds);
+    return bound;
+}
+
+PricingReplay::PricingReplay(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open pricing log '" + path + "'");
+    }
+    std::ostringstream content;
+    content << in.rdbuf();
+    const std::string data = content.str();
+
+    LogReader reader(data);
+    char magic[sizeof(kMagic)];
+    reader.getBytes(magic, sizeof(magic));
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("'" + path + "' is not a pricing log");
+    }
+    if (reader.getU32() != kVersion) {
+        throw std::runtime_error("Unsupported pricing log version in '" + path + "'");
+    }
+
+    std::vector<double> duals;
+    while (!reader.atEnd()) {
+        const uint8_t type = reader.getU8();
+        if (type == kOracleRecord) {
+            oracleNames_.push_back(reader.getString());
+        } else if (type == kStateRecord) {
+            PricingBranchingState state;
+            state.node = reader.getI64();
+            state.bounds.resize(reader.getU32());
+            for (RecordedBound& entry : state.bounds) {
+                entry.index = reader.getI32();
+                entry.lower = reader.getF64();
+                entry.upper = reader.getF64();
+            }
+            states_.push_back(std::move(state));
+        } else if (type == kCallRecord) {
+            RecordedPricingCall call;
+            call.sequence = calls_.size();
+            call.oracle = static_cast<int>(reader.getU32());
+            call.state = static_cast<int>(states_.size()) - 1;
+            if (call.oracle >= static_cast<int>(oracleNames_.size()) || call.state < 0) {
+                throw std::runtime_error("Pricing log call before its oracle or state");
+            }
+            call.bound = reader.getF64();
+            call.seconds = reader.getF64();
+            const uint32_t numDuals = reader.getU32();
+            if (reader.getU8() == kSparseDuals) {
+                if (duals.size() != numDuals) {
+                    throw std::runtime_error("Pricing log changes duals of another size");
+                }
+                const uint32_t changed = reader.getU32();
+                for (uint32_t k = 0; k < changed; ++k) {
+                    const uint32_t index = reader.getU32();
+                    if (index >= numDuals) {
+                        throw std::runtime_error("Pricing log dual index out of range");
+                    }
+                    duals[index] = reader.getF64();
+                }
+            } else {
+                duals.resize(numDuals);
+                reader.getBytes(duals.data(), numDuals * sizeof(double));
+            }
+            call.duals = duals;
+
+            call.columns.resize(reader.getU32());
+            for (Column& column : call.columns) {
+                column.cost = reader.getF64();
+                column.reducedCost = reader.getF64();
+                column.upperBound = reader.getF64();
+                const uint32_t entries = reader.getU32();
+                column.rows.resize(entries);
+                for (int& row : column.rows) {
+                    row = reader.getI32();
+                }
+                column.values.resize(entries);
+                reader.getBytes(column.values.data(), entries * sizeof(double));
+                column.name = reader.getString();
+            }
+            calls_.push_back(std::move(call));
+        } else {
+            throw std::runtime_error("Corrupt pricing log '" + path + "'");
+        }
+    }
+}
+
+std::vector<ReplayCallResult> PricingReplay::run(PricingOracle& oracle, const ReplayParams& params) {
+    std::vector<ReplayCallResult> results;
+    int appliedState = -1;
+    std::vector<Column> columns;
+    for (const RecordedPricingCall& call : calls_) {
+        if (params.maxCalls > 0 && results.size() == params.maxCalls) {
+            break;
+        }
+        if (!params.oracle.empty() && oracleNames_[call.oracle] != params.oracle) {
+            continue;
+        }
+        if (call.state != appliedState) {
+            if (branchingHandler_) {
+                branchingHandler_(states_[call.state]);
+            }
+            appliedState = call.state;
+        }
+
+        ReplayCallResult result;
+        result.sequence = call.sequence;
+        result.node = states_[call.state].node;
+        result.recordedColumns = static_cast<int>(call.columns.size());
+        result.recordedBestReducedCost = bestReducedCost(call.columns);
+        result.recordedBound = call.bound;
+        result.recordedSeconds = call.seconds;
+        result.seconds = std::numeric_limits<double>::infinity();
+        for (int r = 0; r < std::max(params.repetitions, 1); ++r) {
+            columns.clear();
+            if (resetHandler_) {
+                resetHandler_(call);
+            }
+            const auto start = std::chrono::steady_clock::now();
+            result.bound = oracle.price(call.duals, columns);
+            result.seconds = std::min(result.seconds, std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count());
+        }
+        result.columns = static_cast<int>(columns.size());
+        result.bestReducedCost = bestReducedCost(columns);
+        results.push_back(result);
+    }
+    return results;
+}
+
+ReplaySummary PricingReplay::summarize(const std::vector<ReplayCallResult>& results,
+                                       double tolerance) {
+    ReplaySummary summary;
+    for (const ReplayCallResult& result : results) {
+        ++summary.calls;
+        summary.recordedSeconds += result.recordedSeconds;
+        summary.seconds += result.seconds;
+        summary.boundChanges += differs(result.recordedBound, result.bound, tolerance);
+        summary.reducedCostChanges += differs(result.recordedBestReducedCost,
+                                              result.bestReducedCost, tolerance);
+    }
+    return summary;
+}
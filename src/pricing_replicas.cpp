@@ -0,0 +1,125 @@
+#include "../include/pricing_replicas.hpp"
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+PricingReplicas::PricingReplicas(const PricingGraph& graph, const NumaTopology& topology)
+    : topology_(topology), replicas_(topology.getNumNodes()), epoch_(0), job_(nullptr),
+      jobGeneration_(0), jobsPending_(0), stopNodes_(false), errors_(replicas_.size()) {
+    if (!graph.isFinalized()) {
+        throw std::runtime_error("Pricing graph must be finalized before replication");
+    }
+    if (replicas_.size() > 1) {
+        for (int node = 0; node < static_cast<int>(replicas_.size()); ++node) {
+            nodeThreads_.emplace_back(&PricingReplicas::nodeLoop, this, node);
+        }
+    }
+    try {
+        forEachNode([&](int node) {
+            auto replica = std::make_unique<PricingReplica>(graph);
+            replica->node = node;
+            replica->arcReducedCosts.resize(graph.getNumArcs());
+            replicas_[node] = std::move(replica);
+        });
+    } catch (...) {
+        stopNodeThreads();
+        throw;
+    }
+}
+
+PricingReplicas::~PricingReplicas() {
+    stopNodeThreads();
+}
+
+void PricingReplicas::stopNodeThreads() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        stopNodes_ = true;
+    }
+    jobReady_.notify_all();
+    for (std::thread& thread : nodeThreads_) {
+        thread.join();
+    }
+    nodeThreads_.clear();
+}
+
+void PricingReplicas::nodeLoop(int node) {
+    pinCurrentThreadToCpus(topology_.getCpus(node));
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(jobMutex_);
+    for (;;) {
+        jobReady_.wait(lock, [&] { return stopNodes_ || jobGeneration_ != seen; });
+        if (stopNodes_) {
+            return;
+        }
+        seen = jobGeneration_;
+        const std::function<void(int)>& job = *job_;
+        lock.unlock();
+        try {
+            job(node);
+        } catch (...) {
+            errors_[node] = std::current_exception();
+        }
+        lock.lock();
+        if (--jobsPending_ == 0) {
+            jobDone_.notify_all();
+        }
+    }
+}
+
+void PricingReplicas::forEachNode(const std::function<void(int)>& fn) {
+    if (replicas_.size() == 1) {
+        fn(0);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors;
+    {
+        std::unique_lock<std::mutex> lock(jobMutex_);
+        job_ = &fn;
+        errors_.assign(replicas_.size(), nullptr);
+        jobsPending_ = static_cast<int>(replicas_.size());
+        ++jobGeneration_;
+        jobReady_.notify_all();
+        jobDone_.wait(lock, [&] { return jobsPending_ == 0; });
+        job_ = nullptr;
+        errors.swap(errors_);
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void PricingReplicas::publishDuals(const std::vector<double>& duals) {
+    ++epoch_;
+    forEachNode([&](int node) {
+        PricingReplica& replica = *replicas_[node];
+        replica.duals.assign(duals.begin(), duals.end());
+        for (int arc = 0; arc < replica.graph.getNumArcs(); ++arc) {
+            replica.arcReducedCosts[arc] = replica.graph.getReducedCost(arc, replica.duals);
+        }
+        replica.pathDual = replica.graph.getPathDual(replica.duals);
+        replica.epoch = epoch_;
+    });
+}
+
+void PricingReplicas::publishArcStates(const PricingGraph& graph) {
+    if (graph.getNumArcs() != replicas_.front()->graph.getNumArcs()) {
+        throw std::runtime_error("Arc states come from a different pricing graph");
+    }
+    forEachNode([&](int node) {
+        PricingGraph& local = replicas_[node]->graph;
+        for (int arc = 0; arc < graph.getNumArcs(); ++arc) {
+            local.setActive(arc, graph.isActive(arc));
+        }
+    });
+}
+
+const PricingReplica& PricingReplicas::local() const {
+    if (replicas_.size() == 1) {
+        return *replicas_.front();
+    }
+    return *replicas_[topology_.getCurrentNode()];
+}
@@ -0,0 +1,415 @@
+#include "../include/process_pricing_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+// Per-worker control block at the start of the worker's shared-memory region, followed
+// by the dual vector and the column ring
+struct ProcessPricingPool::Channel {
+    std::atomic<uint32_t> request;          // Round counter, bumped by the parent (futex)
+    std::atomic<uint32_t> response;         // Last round the worker finished (futex)
+    std::atomic<uint32_t> shutdown;
+    int32_t failed;
+    double bound;
+    char error[256];
+    alignas(64) std::atomic<uint64_t> head; // Ring bytes written by the worker
+    alignas(64) std::atomic<uint64_t> tail; // Ring bytes consumed by the parent
+};
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t)
+              && std::atomic<uint32_t>::is_always_lock_free,
+              "futex words must be plain 32-bit integers");
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "ring positions must be lock-free across processes");
+
+// Serialized column: count, cost, reduced cost, upper bound, rows, values
+constexpr size_t kRecordHeader = sizeof(uint32_t) + 3 * sizeof(double);
+
+size_t alignTo64(size_t bytes) {
+    return (bytes + 63) & ~size_t(63);
+}
+
+size_t recordBytes(size_t count) {
+    return kRecordHeader + count * (sizeof(int32_t) + sizeof(double));
+}
+
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected, const timespec* timeout) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void ringCopyIn(unsigned char* ring, size_t capacity, uint64_t pos, const void* src, size_t bytes) {
+    const size_t offset = pos & (capacity - 1);
+    const size_t first = std::min(bytes, capacity - offset);
+    std::memcpy(ring + offset, src, first);
+    std::memcpy(ring, static_cast<const unsigned char*>(src) + first, bytes - first);
+}
+
+void ringCopyOut(const unsigned char* ring, size_t capacity, uint64_t pos, void* dst, size_t bytes) {
+    const size_t offset = pos & (capacity - 1);
+    const size_t first = std::min(bytes, capacity - offset);
+    std::memcpy(dst, ring + offset, first);
+    std::memcpy(static_cast<unsigned char*>(dst) + first, ring, bytes - first);
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 64;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+std::string ProcessPricingPool::Proxy::getName() const {
+    return pool_.workers_[worker_].spec.name;
+}
+
+double ProcessPricingPool::Proxy::price(const std::vector<double>& duals,
+                                        std::vector<Column>& columns) {
+    return pool_.take(worker_, duals, columns);
+}
+
+double ProcessPricingPool::Proxy::getMultiplicity() const {
+    return pool_.workers_[worker_].spec.multiplicity;
+}
+
+ProcessPricingPool::ProcessPricingPool(int numRows, const std::vector<PricingWorkerSpec>& workers,
+                                       const ProcessPoolParams& params)
+    : numRows_(numRows), params_(params), memory_(MAP_FAILED), memoryBytes_(0),
+      channelBytes_(0), workers_(workers.size()) {
+    if (numRows_ <= 0 || workers.empty()) {
+        throw std::runtime_error("Process pricing pool needs rows and at least one worker");
+    }
+    params_.ringBytes = roundUpToPowerOfTwo(params_.ringBytes);
+    channelBytes_ = alignTo64(sizeof(Channel)) + alignTo64(numRows_ * sizeof(double))
+                    + params_.ringBytes;
+    memoryBytes_ = channelBytes_ * workers.size();
+
+    // Named segment that is unlinked right away; children inherit the mapping
+    const std::string name = "/cg_pricing_" + std::to_string(getpid()) + "_"
+                             + std::to_string(reinterpret_cast<uintptr_t>(this));
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("shm_open failed for " + name + ": " + std::strerror(errno));
+    }
+    if (ftruncate(fd, static_cast<off_t>(memoryBytes_)) != 0) {
+        const int error = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error(std::string("ftruncate of pricing segment failed: ") + std::strerror(error));
+    }
+    memory_ = mmap(nullptr, memoryBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+    shm_unlink(name.c_str());
+    if (memory_ == MAP_FAILED) {
+        throw std::runtime_error(std::string("mmap of pricing segment failed: ") + std::strerror(error));
+    }
+
+    for (size_t w = 0; w < workers_.size(); ++w) {
+        Worker& worker = workers_[w];
+        if (!workers[w].factory) {
+            throw std::runtime_error("Pricing worker " + workers[w].name + " has no oracle factory");
+        }
+        worker.spec = workers[w];
+        unsigned char* base = static_cast<unsigned char*>(memory_) + w * channelBytes_;
+        worker.channel = new (base) Channel();
+        worker.duals = reinterpret_cast<double*>(base + alignTo64(sizeof(Channel)));
+        worker.ring = base + alignTo64(sizeof(Channel)) + alignTo64(numRows_ * sizeof(double));
+        worker.proxy = std::make_unique<Proxy>(*this, static_cast<int>(w));
+    }
+    for (size_t w = 0; w < workers_.size(); ++w) {
+        spawn(static_cast<int>(w));
+    }
+}
+
+ProcessPricingPool::~ProcessPricingPool() {
+    for (size_t w = 0; w < workers_.size(); ++w) {
+        stop(static_cast<int>(w));
+    }
+    if (memory_ != MAP_FAILED) {
+        munmap(memory_, memoryBytes_);
+    }
+}
+
+void ProcessPricingPool::spawn(int index) {
+    Worker& worker = workers_[index];
+    Channel& channel = *worker.channel;
+    channel.response.store(channel.request.load());
+    channel.shutdown.store(0);
+    channel.failed = 0;
+    channel.head.store(0);
+    channel.tail.store(0);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error(std::string("fork of pricing worker failed: ") + std::strerror(errno));
+    }
+    if (pid == 0) {
+        workerMain(worker, numRows_, params_.ringBytes);
+    }
+    worker.pid = pid;
+}
+
+void ProcessPricingPool::stop(int index) {
+    Worker& worker = workers_[index];
+    if (worker.pid <= 0) {
+        return;
+    }
+    worker.channel->shutdown.store(1);
+    worker.channel->request.fetch_add(1);
+    futexWake(&worker.channel->request);
+
+    // Short grace period, then kill
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        if (waitpid(worker.pid, nullptr, WNOHANG) == worker.pid) {
+            worker.pid = -1;
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    kill(worker.pid, SIGKILL);
+    waitpid(worker.pid, nullptr, 0);
+    worker.pid = -1;
+}
+
+void ProcessPricingPool::workerMain(Worker& worker, int numRows, size_t ringBytes) {
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    Channel& channel = *worker.channel;
+
+    std::unique_ptr<PricingOracle> oracle;
+    std::string setupError;
+    try {
+        oracle = worker.spec.factory();
+        if (!oracle) {
+            setupError = "factory returned no oracle";
+        }
+    } catch (const std::exception& e) {
+        setupError = std::string("factory failed: ") + e.what();
+    }
+
+    std::vector<double> duals(numRows);
+    std::vector<Column> columns;
+    std::vector<unsigned char> record;
+    uint32_t seen = channel.response.load();
+    for (;;) {
+        while (channel.request.load(std::memory_order_acquire) == seen) {
+            futexWait(&channel.request, seen, nullptr);
+        }
+        if (channel.shutdown.load()) {
+            _exit(0);
+        }
+        seen = channel.request.load(std::memory_order_acquire);
+
+        std::string error = setupError;
+        double bound = -std::numeric_limits<double>::infinity();
+        columns.clear();
+        if (oracle) {
+            std::memcpy(duals.data(), worker.duals, numRows * sizeof(double));
+            try {
+                bound = oracle->price(duals, columns);
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+        }
+
+        // Stream the columns; wait for the parent whenever the ring is full
+        for (const Column& column : columns) {
+            if (!error.empty()) {
+                break;
+            }
+            const size_t count = column.rows.size();
+            const size_t bytes = recordBytes(count);
+            if (bytes > ringBytes || column.values.size() != count) {
+                error = "column does not fit the ring or has mismatched values";
+                break;
+            }
+            record.resize(bytes);
+            const uint32_t count32 = static_cast<uint32_t>(count);
+            const double header[3] = {column.cost, column.reducedCost, column.upperBound};
+            std::memcpy(record.data(), &count32, sizeof(count32));
+            std::memcpy(record.data() + sizeof(count32), header, sizeof(header));
+            unsigned char* out = record.data() + kRecordHeader;
+            for (size_t k = 0; k < count; ++k) {
+                const int32_t row = column.rows[k];
+                std::memcpy(out + k * sizeof(int32_t), &row, sizeof(row));
+            }
+            std::memcpy(out + count * sizeof(int32_t), column.values.data(), count * sizeof(double));
+
+            const uint64_t head = channel.head.load(std::memory_order_relaxed);
+            while (ringBytes - (head - channel.tail.load(std::memory_order_acquire)) < bytes) {
+                if (channel.shutdown.load()) {
+                    _exit(0);
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(20));
+            }
+            ringCopyIn(worker.ring, ringBytes, head, record.data(), bytes);
+            channel.head.store(head + bytes, std::memory_order_release);
+        }
+
+        channel.failed = error.empty() ? 0 : 1;
+        std::strncpy(channel.error, error.c_str(), sizeof(channel.error) - 1);
+        channel.error[sizeof(channel.error) - 1] = '\0';
+        channel.bound = bound;
+        channel.response.store(seen, std::memory_order_release);
+        futexWake(&channel.response);
+    }
+}
+
+void ProcessPricingPool::drainRing(Worker& worker) {
+    Channel& channel = *worker.channel;
+    uint64_t tail = channel.tail.load(std::memory_order_relaxed);
+    const uint64_t head = channel.head.load(std::memory_order_acquire);
+    while (tail < head) {
+        uint32_t count = 0;
+        double header[3];
+        ringCopyOut(worker.ring, params_.ringBytes, tail, &count, sizeof(count));
+        ringCopyOut(worker.ring, params_.ringBytes, tail + sizeof(count), header, sizeof(header));
+
+        Column column;
+        column.cost = header[0];
+        column.reducedCost = header[1];
+        column.upperBound = header[2];
+        column.rows.resize(count);
+        column.values.resize(count);
+        std::vector<int32_t> rows(count);
+        ringCopyOut(worker.ring, params_.ringBytes, tail + kRecordHeader,
+                    rows.data(), count * sizeof(int32_t));
+        ringCopyOut(worker.ring, params_.ringBytes, tail + kRecordHeader + count * sizeof(int32_t),
+                    column.values.data(), count * sizeof(double));
+        std::copy(rows.begin(), rows.end(), column.rows.begin());
+        worker.columns.push_back(std::move(column));
+
+        tail += recordBytes(count);
+        ++stats_.columnsReceived;
+    }
+    channel.tail.store(tail, std::memory_order_release);
+}
+
+std::vector<int> ProcessPricingPool::runRound(const std::vector<int>& indices) {
+    for (int index : indices) {
+        Worker& worker = workers_[index];
+        std::memcpy(worker.duals, roundDuals_.data(), numRows_ * sizeof(double));
+        worker.columns.clear();
+        worker.channel->request.fetch_add(1, std::memory_order_release);
+        futexWake(&worker.channel->request);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<int> pending = indices;
+    std::vector<int> crashed;
+    std::string errors;
+    while (!pending.empty()) {
+        for (size_t p = 0; p < pending.size();) {
+            Worker& worker = workers_[pending[p]];
+            Channel& channel = *worker.channel;
+            drainRing(worker);
+
+            bool done = false;
+            if (channel.response.load(std::memory_order_acquire)
+                == channel.request.load(std::memory_order_relaxed)) {
+                drainRing(worker);
+                worker.bound = channel.bound;
+                if (channel.failed) {
+                    errors += "\n  " + worker.spec.name + ": " + channel.error;
+                }
+                done = true;
+            } else if (waitpid(worker.pid, nullptr, WNOHANG) == worker.pid) {
+                worker.pid = -1;
+                crashed.push_back(pending[p]);
+                done = true;
+            } else if (params_.timeoutSeconds > 0.0
+                       && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                          > params_.timeoutSeconds) {
+                kill(worker.pid, SIGKILL);
+                waitpid(worker.pid, nullptr, 0);
+                worker.pid = -1;
+                crashed.push_back(pending[p]);
+                done = true;
+            }
+
+            if (done) {
+                pending.erase(pending.begin() + p);
+            } else {
+                ++p;
+            }
+        }
+
+        if (!pending.empty()) {
+            Channel& channel = *workers_[pending.front()].channel;
+            const timespec timeout = {0, 200000};
+            futexWait(&channel.response, channel.response.load(), &timeout);
+        }
+    }
+
+    if (!errors.empty()) {
+        throw std::runtime_error("Pricing worker failed:" + errors);
+    }
+
+    // Crashed or hung workers: discard partial output and re-fork
+    for (int index : crashed) {
+        Worker& worker = workers_[index];
+        worker.columns.clear();
+        if (worker.restarts >= params_.maxRestarts) {
+            throw std::runtime_error("Pricing worker " + worker.spec.name
+                                     + " exceeded its restart limit");
+        }
+        ++worker.restarts;
+        ++stats_.restarts;
+        spawn(index);
+    }
+    return crashed;
+}
+
+void ProcessPricingPool::priceAll(const std::vector<double>& duals) {
+    if (static_cast<int>(duals.size()) != numRows_) {
+        throw std::runtime_error("Process pricing pool expects " + std::to_string(numRows_)
+                                 + " duals, got " + std::to_string(duals.size()));
+    }
+    roundDuals_ = duals;
+    ++stats_.rounds;
+
+    std::vector<int> all(workers_.size());
+    for (size_t w = 0; w < all.size(); ++w) {
+        all[w] = static_cast<int>(w);
+    }
+    // One retry for the workers that were just restarted
+    const std::vector<int> restarted = runRound(all);
+    if (!restarted.empty() && !runRound(restarted).empty()) {
+        throw std::runtime_error("Pricing worker crashed twice on the same duals");
+    }
+    for (Worker& worker : workers_) {
+        worker.taken = false;
+    }
+}
+
+double ProcessPricingPool::take(int index, const std::vector<double>& duals,
+                                std::vector<Column>& columns) {
+    Worker& worker = workers_[index];
+    if (worker.taken || duals != roundDuals_) {
+        priceAll(duals);
+    }
+    columns.insert(columns.end(), worker.columns.begin(), worker.columns.end());
+    worker.taken = true;
+    return worker.bound;
+}
@@ -0,0 +1,213 @@
+#include "../include/run_log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+static_assert(std::is_trivially_copyable<RunLogRecord>::value, "Run log records are copied as bytes");
+static_assert(sizeof(RunLogRecord) == 64, "Run log records should fill one cache line");
+
+std::atomic<uint64_t> nextSerial{1};
+
+// Last RunLog the thread wrote to and its ring there
+struct LocalRing {
+    uint64_t serial = 0;
+    void* ring = nullptr;
+    uint16_t index = 0;
+};
+thread_local LocalRing tlsRing;
+
+void appendNumber(std::string& out, double value) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    out += buffer;
+}
+
+void appendString(std::string& out, const std::string& value) {
+    out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            out += buffer;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+RunLog::RunLog(const std::string& path, const std::string& run, const RunLogParams& params)
+    : run_(run), params_(params), out_(nullptr), stop_(false) {
+    file_.reset(new std::ofstream(path, std::ios::app));
+    if (!*file_) {
+        throw std::runtime_error("Cannot open run log '" + path + "'");
+    }
+    out_ = file_.get();
+    start();
+}
+
+RunLog::RunLog(std::ostream& out, const std::string& run, const RunLogParams& params)
+    : run_(run), params_(params), out_(&out), stop_(false) {
+    start();
+}
+
+void RunLog::start() {
+    uint64_t capacity = 1;
+    while (capacity < std::max<size_t>(params_.ringCapacity, 2)) {
+        capacity <<= 1;
+    }
+    mask_ = capacity - 1;
+    serial_ = nextSerial.fetch_add(1);
+    start_ = std::chrono::steady_clock::now();
+    flusher_ = std::thread(&RunLog::flusherLoop, this);
+}
+
+RunLog::~RunLog() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    flusher_.join();
+    flush();
+}
+
+RunLog::Ring& RunLog::localRing(uint16_t& index) {
+    if (tlsRing.serial == serial_) {
+        index = tlsRing.index;
+        return *static_cast<Ring*>(tlsRing.ring);
+    }
+    // The cache holds one log only; a thread switching logs finds its ring again here
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    const auto found = ringIndex_.find(std::this_thread::get_id());
+    if (found != ringIndex_.end()) {
+        index = found->second;
+    } else {
+        if (rings_.size() > 0xffff) {
+            throw std::runtime_error("Too many threads writing to one run log");
+        }
+        rings_.emplace_back(new Ring());
+        rings_.back()->records.reset(new RunLogRecord[mask_ + 1]);
+        index = static_cast<uint16_t>(rings_.size() - 1);
+        ringIndex_.emplace(std::this_thread::get_id(), index);
+    }
+    tlsRing.serial = serial_;
+    tlsRing.ring = rings_[index].get();
+    tlsRing.index = index;
+    return *rings_[index];
+}
+
+bool RunLog::write(RunLogRecord record) {
+    uint16_t index;
+    Ring& ring = localRing(index);
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) > mask_) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    record.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    record.thread = index;
+    ring.records[head & mask_] = record;
+    ring.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void RunLog::flush() {
+    std::lock_guard<std::mutex> lock(exportMutex_);
+    std::vector<Ring*> rings;
+    {
+        std::lock_guard<std::mutex> ringsLock(ringsMutex_);
+        for (const auto& ring : rings_) {
+            rings.push_back(ring.get());
+        }
+    }
+
+    batch_.clear();
+    for (Ring* ring : rings) {
+        const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (uint64_t k = tail; k < head; ++k) {
+            batch_.push_back(ring->records[k & mask_]);
+        }
+        ring->tail.store(head, std::memory_order_release);
+    }
+    if (batch_.empty()) {
+        return;
+    }
+
+    // Every ring is in time order already; the merge only interleaves threads
+    std::stable_sort(batch_.begin(), batch_.end(),
+                     [](const RunLogRecord& a, const RunLogRecord& b) { return a.time < b.time; });
+    std::string text;
+    for (const RunLogRecord& record : batch_) {
+        text += toJson(record, run_);
+        text += '\n';
+    }
+    out_->write(text.data(), static_cast<std::streamsize>(text.size()));
+    out_->flush();
+    stats_.written += batch_.size();
+    stats_.bytes += text.size();
+    ++stats_.flushes;
+}
+
+void RunLog::flusherLoop() {
+    const auto interval = std::chrono::duration<double>(params_.flushInterval);
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    while (!stop_) {
+        wake_.wait_for(lock, interval, [this] { return stop_; });
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+RunLogStats RunLog::getStats() const {
+    RunLogStats stats;
+    {
+        std::lock_guard<std::mutex> lock(exportMutex_);
+        stats = stats_;
+    }
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    for (const auto& ring : rings_) {
+        stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+std::string RunLog::toJson(const RunLogRecord& record, const std::string& run) {
+    std::string out = "{\"run\":";
+    appendString(out, run);
+    out += ",\"t\":";
+    appendNumber(out, record.time);
+    out += ",\"thread\":" + std::to_string(record.thread);
+    out += record.event == RunLogEvent::Finished ? ",\"event\":\"finished\"" : ",\"event\":\"iteration\"";
+    out += ",\"iteration\":" + std::to_string(record.iteration);
+    out += ",\"objective\":";
+    appendNumber(out, record.objective);
+    out += ",\"bound\":";
+    appendNumber(out, record.bound);
+    out += ",\"columns_added\":" + std::to_string(record.columnsAdded);
+    out += ",\"columns\":" + std::to_string(record.columns);
+    out += ",\"master_s\":";
+    appendNumber(out, record.masterSeconds);
+    out += ",\"pricing_s\":";
+    appendNumber(out, record.pricingSeconds);
+    if (record.event == RunLogEvent::Finished) {
+        out += record.optimal ? ",\"optimal\":true" : ",\"optimal\":false";
+    }
+    out += '}';
+    return out;
+}
@@ -0,0 +1,355 @@
+#include "../include/scenario_solver.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+// Record: uint32 payload bytes, then int32 scenario, int32 ok, int32 status, double
+// objective, double dual bound, double seconds, uint32 error length, error bytes,
+// uint32 values, values
+template <typename T>
+void append(std::vector<char>& buffer, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T read(const char*& cursor) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+bool writeAll(int fd, const char* data, size_t bytes) {
+    while (bytes > 0) {
+        const ssize_t n = ::write(fd, data, bytes);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        bytes -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+ScenarioSolver::ScenarioSolver(ScipSolver& base, const std::vector<ScipVariable*>& variables,
+                               const std::vector<ScipConstraint*>& rows,
+                               const ScenarioParams& params)
+    : base_(base), variables_(variables), rows_(rows), params_(params) {
+    if (params_.numWorkers <= 0) {
+        params_.numWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+void ScenarioSolver::runWorker(const std::vector<Scenario>& scenarios, std::atomic<int>* next,
+                               int fd) {
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+
+    // Base values of everything a scenario may touch, to undo it afterwards
+    std::vector<double> lhs(rows_.size()), rhs(rows_.size());
+    std::vector<double> lb(variables_.size()), ub(variables_.size()), obj(variables_.size());
+    std::vector<char> record;
+    try {
+        base_.freeTransform();
+        base_.setVerbosity(0);
+        base_.setTimeLimit(params_.timeLimit);
+        for (size_t i = 0; i < rows_.size(); ++i) {
+            lhs[i] = rows_[i]->getLhs();
+            rhs[i] = rows_[i]->getRhs();
+        }
+        for (size_t j = 0; j < variables_.size(); ++j) {
+            lb[j] = variables_[j]->getLowerBound();
+            ub[j] = variables_[j]->getUpperBound();
+            obj[j] = variables_[j]->getObjective();
+        }
+    } catch (const std::exception&) {
+        _exit(1);       // The parent reports the scenarios as unsolved
+    }
+
+    const double inf = SCIPinfinity(base_.get());
+    auto clamp = [inf](double value) { return std::max(-inf, std::min(inf, value)); };
+    // Lhs is relaxed first so no intermediate state has lhs > rhs
+    auto setSides = [&](int row, double newLhs, double newRhs) {
+        rows_[row]->setLhs(-inf);
+        rows_[row]->setRhs(clamp(newRhs));
+        rows_[row]->setLhs(clamp(newLhs));
+    };
+    auto validVariable = [&](int variable) {
+        return variable >= 0 && variable < static_cast<int>(variables_.size());
+    };
+    auto checkVariable = [&](int variable) {
+        if (!validVariable(variable)) {
+            throw std::runtime_error("Scenario variable index " + std::to_string(variable)
+                                     + " out of range");
+        }
+    };
+
+    for (;;) {
+        const int s = next->fetch_add(1);
+        if (s >= static_cast<int>(scenarios.size())) {
+            break;
+        }
+        const Scenario& scenario = scenarios[s];
+        int32_t ok = 1;
+        std::string error;
+        SCIP_STATUS status = SCIP_STATUS_UNKNOWN;
+        double objective = 0.0;
+        double dualBound = 0.0;
+        std::vector<double> values;
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            for (const Scenario::RowChange& change : scenario.rows) {
+                if (change.row < 0 || change.row >= static_cast<int>(rows_.size())) {
+                    throw std::runtime_error("Scenario row index " + std::to_string(change.row)
+                                             + " out of range");
+                }
+                setSides(change.row, change.lhs, change.rhs);
+            }
+            for (const Scenario::BoundChange& change : scenario.bounds) {
+                checkVariable(change.variable);
+                variables_[change.variable]->setBounds(clamp(change.lb), clamp(change.ub));
+            }
+            for (const Scenario::ObjectiveChange& change : scenario.objectives) {
+                checkVariable(change.variable);
+                variables_[change.variable]->setObjective(change.obj);
+            }
+
+            base_.solve();
+            status = base_.getStatus();
+            dualBound = base_.getDualBound();
+            if (SCIPgetNSols(base_.get()) > 0) {
+                objective = base_.getObjectiveValue();
+                if (params_.collectValues) {
+                    values.reserve(variables_.size());
+                    for (ScipVariable* variable : variables_) {
+                        values.push_back(variable->getSolutionValue());
+                    }
+                }
+            } else {
+                objective = SCIPgetObjsense(base_.get()) == SCIP_OBJSENSE_MAXIMIZE
+                            ? -std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::infinity();
+            }
+        } catch (const std::exception& e) {
+            ok = 0;
+            error = e.what();
+        }
+        const double seconds = secondsSince(start);
+
+        // Back to the base model for the next scenario of this worker
+        bool restored = true;
+        try {
+            base_.freeTransform();
+            for (const Scenario::RowChange& change : scenario.rows) {
+                if (change.row >= 0 && change.row < static_cast<int>(rows_.size())) {
+                    setSides(change.row, lhs[change.row], rhs[change.row]);
+                }
+            }
+            for (const Scenario::BoundChange& change : scenario.bounds) {
+                if (validVariable(change.variable)) {
+                    variables_[change.variable]->setBounds(lb[change.variable], ub[change.variable]);
+                }
+            }
+            for (const Scenario::ObjectiveChange& change : scenario.objectives) {
+                if (validVariable(change.variable)) {
+                    variables_[change.variable]->setObjective(obj[change.variable]);
+                }
+            }
+        } catch (const std::exception& e) {
+            ok = 0;
+            restored = false;
+            error = std::string("restoring the base model failed: ") + e.what();
+        }
+
+        record.clear();
+        append<uint32_t>(record, 0);
+        append<int32_t>(record, s);
+        append<int32_t>(record, ok);
+        append<int32_t>(record, static_cast<int32_t>(status));
+        append<double>(record, objective);
+        append<double>(record, dualBound);
+        append<double>(record, seconds);
+        append<uint32_t>(record, static_cast<uint32_t>(error.size()));
+        record.insert(record.end(), error.begin(), error.end());
+        append<uint32_t>(record, static_cast<uint32_t>(values.size()));
+        for (double value : values) {
+            append<double>(record, value);
+        }
+        const uint32_t payload = static_cast<uint32_t>(record.size() - sizeof(uint32_t));
+        std::memcpy(record.data(), &payload, sizeof(payload));
+        if (!writeAll(fd, record.data(), record.size())) {
+            _exit(1);
+        }
+        if (!restored) {
+            _exit(1);   // Base model is unknown now; leave the rest to other workers
+        }
+    }
+    _exit(0);
+}
+
+std::vector<ScenarioResult> ScenarioSolver::solve(const std::vector<Scenario>& scenarios) {
+    const auto start = std::chrono::steady_clock::now();
+    stats_ = ScenarioStats();
+    stats_.scenarios = static_cast<int>(scenarios.size());
+
+    std::vector<ScenarioResult> results(scenarios.size());
+    for (size_t s = 0; s < scenarios.size(); ++s) {
+        results[s].name = scenarios[s].name;
+        results[s].error = "worker terminated before reporting";
+    }
+    if (scenarios.empty()) {
+        return results;
+    }
+
+    // Shared claim counter; everything else reaches the workers by copy-on-write
+    void* shared = mmap(nullptr, sizeof(std::atomic<int>), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        throw std::runtime_error(std::string("mmap of scenario counter failed: ")
+                                 + std::strerror(errno));
+    }
+    std::atomic<int>* next = new (shared) std::atomic<int>(0);
+
+    const int numWorkers = std::min<int>(params_.numWorkers, static_cast<int>(scenarios.size()));
+    std::vector<pid_t> pids;
+    std::vector<int> fds;
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    for (int w = 0; w < numWorkers; ++w) {
+        int pipeFds[2];
+        if (pipe(pipeFds) != 0) {
+            break;
+        }
+        const pid_t pid = fork();
+        if (pid < 0) {
+            ::close(pipeFds[0]);
+            ::close(pipeFds[1]);
+            break;
+        }
+        if (pid == 0) {
+            ::close(pipeFds[0]);
+            for (int fd : fds) {
+                ::close(fd);
+            }
+            runWorker(scenarios, next, pipeFds[1]);
+        }
+        ::close(pipeFds[1]);
+        pids.push_back(pid);
+        fds.push_back(pipeFds[0]);
+    }
+    stats_.workers = static_cast<int>(pids.size());
+    if (pids.empty()) {
+        munmap(shared, sizeof(std::atomic<int>));
+        throw std::runtime_error(std::string("fork of scenario workers failed: ")
+                                 + std::strerror(errno));
+    }
+
+    // Read all pipes until every worker closed its end
+    std::vector<std::string> buffers(fds.size());
+    std::vector<pollfd> polls;
+    std::vector<int> open(fds.size(), 1);
+    int remaining = static_cast<int>(fds.size());
+    char chunk[65536];
+    while (remaining > 0) {
+        polls.clear();
+        std::vector<int> index;
+        for (size_t w = 0; w < fds.size(); ++w) {
+            if (open[w]) {
+                polls.push_back({fds[w], POLLIN, 0});
+                index.push_back(static_cast<int>(w));
+            }
+        }
+        if (::poll(polls.data(), polls.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (size_t p = 0; p < polls.size(); ++p) {
+            if (!polls[p].revents) {
+                continue;
+            }
+            const int w = index[p];
+            const ssize_t n = ::read(fds[w], chunk, sizeof(chunk));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                open[w] = 0;
+                --remaining;
+                continue;
+            }
+            std::string& buffer = buffers[w];
+            buffer.append(chunk, static_cast<size_t>(n));
+
+            size_t used = 0;
+            while (buffer.size() - used >= sizeof(uint32_t)) {
+                uint32_t payload;
+                std::memcpy(&payload, buffer.data() + used, sizeof(payload));
+                if (buffer.size() - used - sizeof(uint32_t) < payload) {
+                    break;
+                }
+                const char* cursor = buffer.data() + used + sizeof(uint32_t);
+                const int32_t s = read<int32_t>(cursor);
+                ScenarioResult& result = results.at(s);
+                result.ok = read<int32_t>(cursor) != 0;
+                result.status = static_cast<SCIP_STATUS>(read<int32_t>(cursor));
+                result.objective = read<double>(cursor);
+                result.dualBound = read<double>(cursor);
+                result.seconds = read<double>(cursor);
+                const uint32_t errorBytes = read<uint32_t>(cursor);
+                result.error.assign(cursor, errorBytes);
+                cursor += errorBytes;
+                result.values.resize(read<uint32_t>(cursor));
+                for (double& value : result.values) {
+                    value = read<double>(cursor);
+                }
+                result.worker = w;
+                used += sizeof(uint32_t) + payload;
+            }
+            buffer.erase(0, used);
+        }
+    }
+
+    for (size_t w = 0; w < pids.size(); ++w) {
+        ::close(fds[w]);
+        waitpid(pids[w], nullptr, 0);
+    }
+    munmap(shared, sizeof(std::atomic<int>));
+
+    for (const ScenarioResult& result : results) {
+        if (result.ok) {
+            ++stats_.solved;
+            stats_.solveTime += result.seconds;
+        } else {
+            ++stats_.failed;
+        }
+    }
+    stats_.wallTime = secondsSince(start);
+    return results;
+}
@@ -49,7 +49,11 @@ double ScipConstraint::getDualValue() const {
     if (cons_ == nullptr) {
         throw std::runtime_error("Constraint not initialized");
     }
-    return SCIPgetDualsolLinear(scip_, cons_);
+    // Works on the original constraint (the LP row belongs to the transformed one)
+    double dual = 0.0;
+    SCIP_Bool boundConstraint = FALSE;
+    SCIP_CALL_EXCEPT(SCIPgetDualSolVal(scip_, cons_, &dual, &boundConstraint));
+    return dual;
 }
 
 ScipConstraint::ScipConstraint(ScipConstraint&& other) noexcept
@@ -97,4 +101,39 @@ void ScipConstraint::addVariable(ScipVariable* variable, double coefficient) {
     // Update internal tracking
     vars_.push_back(variable->get());
     coeffs_.push_back(coefficient);
-}
\ No newline at end of file
+}
+
+std::string ScipConstraint::getName() const {
+    if (cons_ == nullptr) {
+        return "[invalid constraint]";
+    }
+    return SCIPconsGetName(cons_);
+}
+
+double ScipConstraint::getLhs() const {
+    if (cons_ == nullptr) {
+        throw std::runtime_error("Constraint not initialized");
+    }
+    return SCIPgetLhsLinear(scip_, cons_);
+}
+
+double ScipConstraint::getRhs() const {
+    if (cons_ == nullptr) {
+        throw std::runtime_error("Constraint not initialized");
+    }
+    return SCIPgetRhsLinear(scip_, cons_);
+}
+
+void ScipConstraint::setLhs(double lhs) {
+    if (cons_ == nullptr) {
+        throw std::runtime_error("Constraint not initialized");
+    }
+    SCIP_CALL_EXCEPT(SCIPchgLhsLinear(scip_, cons_, lhs));
+}
+
+void ScipConstraint::setRhs(double rhs) {
+    if (cons_ == nullptr) {
+        throw std::runtime_error("Constraint not initialized");
+    }
+    SCIP_CALL_EXCEPT(SCIPchgRhsLinear(scip_, cons_, rhs));
+}
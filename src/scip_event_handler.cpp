@@ -0,0 +1,147 @@
+#include "../include/scip_event_handler.hpp"
+#include <stdexcept>
+
+namespace {
+
+ScipEventHandler* owner(SCIP_EVENTHDLR* eventhdlr) {
+    return reinterpret_cast<ScipEventHandler*>(SCIPeventhdlrGetData(eventhdlr));
+}
+
+} // namespace
+
+ScipEventHandler::ScipEventHandler(ScipSolver& solver, const std::string& name)
+    : scip_(solver.get()), handler_(nullptr), counts_{}, globalMask_(0), globalFilter_(-1) {
+    handler_ = SCIPfindEventhdlr(scip_, name.c_str());
+    if (handler_ != nullptr) {
+        if (SCIPeventhdlrGetData(handler_) != nullptr) {
+            throw std::runtime_error("Event handler '" + name + "' is already in use");
+        }
+        SCIPeventhdlrSetData(handler_, reinterpret_cast<SCIP_EVENTHDLRDATA*>(this));
+        return;
+    }
+    SCIP_CALL_EXCEPT( SCIPincludeEventhdlrBasic(scip_, &handler_, name.c_str(),
+                                                "C++ event callbacks", eventExec,
+                                                reinterpret_cast<SCIP_EVENTHDLRDATA*>(this)) );
+    SCIP_CALL_EXCEPT( SCIPsetEventhdlrInit(scip_, handler_, eventInit) );
+    SCIP_CALL_EXCEPT( SCIPsetEventhdlrExit(scip_, handler_, eventExit) );
+}
+
+ScipEventHandler::~ScipEventHandler() {
+    // Destroyed mid-solve: stop the events reaching a dead object
+    (void)dropAll();
+    SCIPeventhdlrSetData(handler_, nullptr);
+}
+
+void ScipEventHandler::setCallback(ScipEventKind kind, ScipEventCallback callback) {
+    callbacks_[static_cast<int>(kind)] = std::move(callback);
+}
+
+void ScipEventHandler::rethrowIfFailed() {
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+SCIP_RETCODE ScipEventHandler::catchAll() {
+    globalMask_ = 0;
+    if (callbacks_[static_cast<int>(ScipEventKind::LpSolved)]) {
+        globalMask_ |= SCIP_EVENTTYPE_LPEVENT;
+    }
+    if (callbacks_[static_cast<int>(ScipEventKind::NodeSolved)]) {
+        globalMask_ |= SCIP_EVENTTYPE_NODESOLVED;
+    }
+    if (callbacks_[static_cast<int>(ScipEventKind::BestSolutionFound)]) {
+        globalMask_ |= SCIP_EVENTTYPE_BESTSOLFOUND;
+    }
+    if (callbacks_[static_cast<int>(ScipEventKind::VariableDeleted)]) {
+        // Deletion is a per-variable event; variables priced in later are caught on arrival
+        globalMask_ |= SCIP_EVENTTYPE_VARADDED;
+        SCIP_VAR** vars = SCIPgetVars(scip_);
+        const int numVars = SCIPgetNVars(scip_);
+        for (int j = 0; j < numVars; ++j) {
+            int filter = -1;
+            SCIP_CALL( SCIPcatchVarEvent(scip_, vars[j], SCIP_EVENTTYPE_VARDELETED, handler_,
+                                         nullptr, &filter) );
+            varFilters_[vars[j]] = filter;
+        }
+    }
+    if (globalMask_ != 0) {
+        SCIP_CALL( SCIPcatchEvent(scip_, globalMask_, handler_, nullptr, &globalFilter_) );
+    }
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE ScipEventHandler::dropAll() {
+    if (globalFilter_ >= 0) {
+        SCIP_CALL( SCIPdropEvent(scip_, globalMask_, handler_, nullptr, globalFilter_) );
+        globalFilter_ = -1;
+    }
+    for (const auto& entry : varFilters_) {
+        SCIP_CALL( SCIPdropVarEvent(scip_, entry.first, SCIP_EVENTTYPE_VARDELETED, handler_,
+                                    nullptr, entry.second) );
+    }
+    varFilters_.clear();
+    return SCIP_OKAY;
+}
+
+void ScipEventHandler::dispatch(ScipEventKind kind, const ScipEvent& event) {
+    ++counts_[static_cast<int>(kind)];
+    if (error_) {
+        return;     // Solve is being interrupted
+    }
+    try {
+        callbacks_[static_cast<int>(kind)](event);
+    } catch (...) {
+        error_ = std::current_exception();
+        (void)SCIPinterruptSolve(scip_);
+    }
+}
+
+SCIP_RETCODE ScipEventHandler::eventInit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) {
+    (void)scip;
+    ScipEventHandler* self = owner(eventhdlr);
+    return self == nullptr ? SCIP_OKAY : self->catchAll();
+}
+
+SCIP_RETCODE ScipEventHandler::eventExit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) {
+    (void)scip;
+    ScipEventHandler* self = owner(eventhdlr);
+    return self == nullptr ? SCIP_OKAY : self->dropAll();
+}
+
+SCIP_RETCODE ScipEventHandler::eventExec(SCIP* scip, SCIP_EVENTHDLR* eventhdlr,
+                                         SCIP_EVENT* event, SCIP_EVENTDATA* eventdata) {
+    (void)eventdata;
+    ScipEventHandler* self = owner(eventhdlr);
+    if (self == nullptr) {
+        return SCIP_OKAY;
+    }
+
+    const SCIP_EVENTTYPE type = SCIPeventGetType(event);
+    ScipEvent info{ScipEventKind::LpSolved, scip};
+    if (type & SCIP_EVENTTYPE_LPEVENT) {
+        self->dispatch(ScipEventKind::LpSolved, info);
+    } else if (type & SCIP_EVENTTYPE_NODESOLVED) {
+        info.kind = ScipEventKind::NodeSolved;
+        info.node = SCIPeventGetNode(event);
+        self->dispatch(info.kind, info);
+    } else if (type & SCIP_EVENTTYPE_BESTSOLFOUND) {
+        info.kind = ScipEventKind::BestSolutionFound;
+        info.solution = SCIPeventGetSol(event);
+        self->dispatch(info.kind, info);
+    } else if (type & SCIP_EVENTTYPE_VARDELETED) {
+        info.kind = ScipEventKind::VariableDeleted;
+        info.variable = SCIPeventGetVar(event);
+        self->varFilters_.erase(info.variable);     // Nothing left to drop
+        self->dispatch(info.kind, info);
+    } else if (type & SCIP_EVENTTYPE_VARADDED) {
+        SCIP_VAR* var = SCIPeventGetVar(event);
+        int filter = -1;
+        SCIP_CALL( SCIPcatchVarEvent(scip, var, SCIP_EVENTTYPE_VARDELETED, eventhdlr, nullptr,
+                                     &filter) );
+        self->varFilters_[var] = filter;
+    }
+    return SCIP_OKAY;
+}
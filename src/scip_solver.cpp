@@ -1,4 +1,5 @@
 #include "../include/scip_solver.hpp"
+#include <cmath>
 #include <stdexcept>
 
 // Constructor
@@ -55,6 +56,59 @@ double ScipSolver::getObjectiveValue() const {
     return SCIPgetPrimalbound(scip_);
 }
 
+void ScipSolver::freeTransform() {
+    SCIP_CALL_EXCEPT( SCIPfreeTransform(scip_) );
+}
+
+void ScipSolver::reset(const std::string& name) {
+    SCIP_CALL_EXCEPT( SCIPfreeProb(scip_) );
+    SCIP_CALL_EXCEPT( SCIPresetParams(scip_) );
+    SCIP_CALL_EXCEPT( SCIPcreateProbBasic(scip_, name.c_str()) );
+    SCIP_CALL_EXCEPT( SCIPsetObjsense(scip_, SCIP_OBJSENSE_MINIMIZE) );
+}
+
+void ScipSolver::setTimeLimit(double seconds) {
+    SCIP_CALL_EXCEPT( SCIPsetRealParam(scip_, "limits/time",
+                                       std::isinf(seconds) ? SCIPinfinity(scip_) : seconds) );
+}
+
+double ScipSolver::getSolvingTime() const {
+    return SCIPgetSolvingTime(scip_);
+}
+
+double ScipSolver::getDualBound() const {
+    return SCIPgetDualbound(scip_);
+}
+
+void ScipSolver::setColumnGenerationMode() {
+    SCIP_CALL_EXCEPT( SCIPsetPresolving(scip_, SCIP_PARAMSETTING_OFF, TRUE) );
+    SCIP_CALL_EXCEPT( SCIPsetHeuristics(scip_, SCIP_PARAMSETTING_OFF, TRUE) );
+    SCIP_CALL_EXCEPT( SCIPsetSeparating(scip_, SCIP_PARAMSETTING_OFF, TRUE) );
+    SCIP_CALL_EXCEPT( SCIPsetIntParam(scip_, "propagating/maxrounds", 0) );
+    SCIP_CALL_EXCEPT( SCIPsetIntParam(scip_, "propagating/maxroundsroot", 0) );
+    setVerbosity(0);
+}
+
+void ScipSolver::setSymmetryHandling(int mode) {
+    SCIP_CALL_EXCEPT( SCIPsetIntParam(scip_, "misc/usesymmetry", mode) );
+}
+
+void ScipSolver::setVerbosity(int level) {
+    SCIP_CALL_EXCEPT( SCIPsetIntParam(scip_, "display/verblevel", level) );
+}
+
+std::vector<double> ScipSolver::getDualValues(const std::vector<ScipConstraint*>& rows) const {
+    std::vector<double> duals(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (rows[i] == nullptr) {
+            throw std::runtime_error("Null constraint pointer in dual query");
+        }
+        SCIP_Bool boundConstraint = FALSE;
+        SCIP_CALL_EXCEPT( SCIPgetDualSolVal(scip_, rows[i]->get(), &duals[i], &boundConstraint) );
+    }
+    return duals;
+}
+
 // Variable factory
 ScipVariable ScipSolver::createVariable(const std::string& name,
                                        double lb, double ub, double obj,
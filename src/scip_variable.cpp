@@ -65,4 +65,47 @@ std::string ScipVariable::getName() const {
         return "[invalid variable]";
     }
     return SCIPvarGetName(var_);  // SCIP function to get variable name
+}
+
+double ScipVariable::getObjective() const {
+    if (var_ == nullptr) {
+        throw std::runtime_error("Variable not initialized or moved from");
+    }
+    return SCIPvarGetObj(var_);
+}
+
+double ScipVariable::getLowerBound() const {
+    if (var_ == nullptr) {
+        throw std::runtime_error("Variable not initialized or moved from");
+    }
+    return SCIPvarGetLbOriginal(var_);
+}
+
+double ScipVariable::getUpperBound() const {
+    if (var_ == nullptr) {
+        throw std::runtime_error("Variable not initialized or moved from");
+    }
+    return SCIPvarGetUbOriginal(var_);
+}
+
+SCIP_VARTYPE ScipVariable::getType() const {
+    if (var_ == nullptr) {
+        throw std::runtime_error("Variable not initialized or moved from");
+    }
+    return SCIPvarGetType(var_);
+}
+
+void ScipVariable::setObjective(double obj) {
+    if (var_ == nullptr) {
+        throw std::runtime_error("Variable not initialized or moved from");
+    }
+    SCIP_CALL_EXCEPT(SCIPchgVarObj(scip_, var_, obj));
+}
+
+void ScipVariable::setBounds(double lb, double ub) {
+    if (var_ == nullptr) {
+        throw std::runtime_error("Variable not initialized or moved from");
+    }
+    SCIP_CALL_EXCEPT(SCIPchgVarLb(scip_, var_, lb));
+    SCIP_CALL_EXCEPT(SCIPchgVarUb(scip_, var_, ub));
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "../include/sifting_solver.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+SiftingSolver::SiftingSolver(ScipSolver& master, const std::vector<ScipConstraint*>& rows,
+                             const ColumnStore& store, const SiftingParams& params)
+    : store_(store),
+      params_(params),
+      pricer_(store, params.columnsPerIteration, params.reducedCostTolerance),
+      cg_(master, rows) {
+    if (static_cast<int>(rows.size()) != store_.getNumRows()) {
+        throw std::runtime_error("Sifting master rows do not match the column store");
+    }
+    cg_.addOracle(&pricer_);
+}
+
+void SiftingSolver::seedWorkingSet() {
+    const int perRow = std::max(1, params_.seedColumnsPerRow);
+    const int numRows = store_.getNumRows();
+
+    // Per row, the perRow cheapest columns seen so far (small sorted lists)
+    std::vector<std::vector<std::pair<double, size_t>>> cheapest(numRows);
+    for (size_t j = 0; j < store_.size(); ++j) {
+        const double cost = store_.getCost(j);
+        const auto rows = store_.getRows(j);
+        for (const int32_t* row = rows.first; row != rows.second; ++row) {
+            auto& list = cheapest[*row];
+            if (static_cast<int>(list.size()) == perRow && cost >= list.back().first) {
+                continue;
+            }
+            list.insert(std::upper_bound(list.begin(), list.end(), std::make_pair(cost, j)),
+                        std::make_pair(cost, j));
+            if (static_cast<int>(list.size()) > perRow) {
+                list.pop_back();
+            }
+        }
+    }
+
+    std::unordered_set<size_t> chosen;
+    for (const auto& list : cheapest) {
+        for (const auto& entry : list) {
+            if (chosen.insert(entry.second).second) {
+                cg_.addColumn(store_.getColumn(entry.second));
+            }
+        }
+    }
+}
+
+ColumnGenerationStats SiftingSolver::solve() {
+    ColumnGenerationParams params;
+    params.maxIterations = params_.maxIterations;
+    params.maxColumnsPerIteration = params_.columnsPerIteration;
+    params.reducedCostTolerance = params_.reducedCostTolerance;
+    params.verbose = params_.verbose;
+    return cg_.run(params);
+}
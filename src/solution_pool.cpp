@@ -0,0 +1,60 @@
+#include "../include/solution_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+double ScipSolution::getValue(int index) const {
+    auto it = std::lower_bound(indices.begin(), indices.end(), index);
+    if (it == indices.end() || *it != index) {
+        return 0.0;
+    }
+    return values[it - indices.begin()];
+}
+
+ScipSolutionPool::ScipSolutionPool(ScipSolver& solver, const std::vector<ScipVariable*>& variables,
+                                   double zeroTolerance)
+    : scip_(solver.get()), zeroTolerance_(zeroTolerance), buffer_(variables.size()) {
+    vars_.reserve(variables.size());
+    for (ScipVariable* variable : variables) {
+        vars_.push_back(variable->get());
+    }
+}
+
+size_t ScipSolutionPool::size() const {
+    return static_cast<size_t>(SCIPgetNSols(scip_));
+}
+
+ScipSolution ScipSolutionPool::getSolution(size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("Solution " + std::to_string(index) + " not in the pool");
+    }
+    return extract(SCIPgetSols(scip_)[index]);
+}
+
+ScipSolution ScipSolutionPool::extract(SCIP_SOL* solution) const {
+    ScipSolution result;
+    result.objective = SCIPgetSolOrigObj(scip_, solution);
+    result.time = SCIPgetSolTime(scip_, solution);
+    if (!vars_.empty()) {
+        SCIP_CALL_EXCEPT( SCIPgetSolVals(scip_, solution, static_cast<int>(vars_.size()),
+                                         vars_.data(), buffer_.data()) );
+    }
+    for (size_t j = 0; j < buffer_.size(); ++j) {
+        if (std::abs(buffer_[j]) > zeroTolerance_) {
+            result.indices.push_back(static_cast<int>(j));
+            result.values.push_back(buffer_[j]);
+        }
+    }
+    return result;
+}
+
+IncumbentStream::IncumbentStream(ScipSolver& solver, const std::vector<ScipVariable*>& variables,
+                                 IncumbentCallback callback, const std::string& name)
+    : pool_(solver, variables), events_(solver, name), callback_(std::move(callback)),
+      delivered_(0) {
+    events_.onBestSolutionFound([this](const ScipEvent& event) {
+        const ScipSolution solution = pool_.extract(event.solution);
+        ++delivered_;
+        callback_(solution);
+    });
+}
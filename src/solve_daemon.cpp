@@ -0,0 +1,678 @@
+#include "../include/solve_daemon.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <unordered_map>
+#include "../include/column_generation.hpp"
+#include "../include/column_store.hpp"
+
+namespace {
+
+const double kInf = std::numeric_limits<double>::infinity();
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double parseNumber(const std::string& token) {
+    if (token == "inf" || token == "+inf") {
+        return kInf;
+    }
+    if (token == "-inf") {
+        return -kInf;
+    }
+    size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(token, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used != token.size() || token.empty()) {
+        throw std::runtime_error("Invalid number '" + token + "'");
+    }
+    return value;
+}
+
+// "<name>:<coef>"
+std::pair<std::string, double> parseTerm(const std::string& token) {
+    const size_t colon = token.rfind(':');
+    if (colon == std::string::npos || colon == 0) {
+        throw std::runtime_error("Invalid term '" + token + "', expected name:coefficient");
+    }
+    return {token.substr(0, colon), parseNumber(token.substr(colon + 1))};
+}
+
+std::vector<std::string> tokenize(const std::string& line) {
+    std::vector<std::string> tokens;
+    std::istringstream in(line);
+    std::string token;
+    while (in >> token) {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+std::string formatNumber(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "inf" : "-inf";
+    }
+    std::ostringstream out;
+    out.precision(17);
+    out << value;
+    return out.str();
+}
+
+std::string statusName(SCIP_STATUS status) {
+    switch (status) {
+    case SCIP_STATUS_OPTIMAL: return "optimal";
+    case SCIP_STATUS_INFEASIBLE: return "infeasible";
+    case SCIP_STATUS_UNBOUNDED: return "unbounded";
+    case SCIP_STATUS_INFORUNBD: return "infeasible_or_unbounded";
+    case SCIP_STATUS_TIMELIMIT: return "timelimit";
+    default: return "status_" + std::to_string(static_cast<int>(status));
+    }
+}
+
+} // namespace
+
+// One client socket; jobs keep it alive until their results are written
+struct SolveDaemon::Connection {
+    int fd;
+    std::mutex writeMutex;
+
+    explicit Connection(int socket) : fd(socket) {}
+    ~Connection() { ::close(fd); }
+
+    // Whole lines are written under the lock, so results of concurrent jobs never interleave
+    void send(const std::vector<std::string>& lines) {
+        std::string data;
+        for (const std::string& line : lines) {
+            data += line;
+            data += '\n';
+        }
+        std::lock_guard<std::mutex> lock(writeMutex);
+        size_t sent = 0;
+        while (sent < data.size()) {
+            const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return;     // Client went away; the job still counts as completed
+            }
+            sent += static_cast<size_t>(n);
+        }
+    }
+};
+
+SolveJob SolveDaemon::parseJob(const std::vector<std::string>& lines) {
+    SolveJob job;
+    bool ended = false;
+    for (size_t l = 0; l < lines.size(); ++l) {
+        const std::vector<std::string> tokens = tokenize(lines[l]);
+        if (tokens.empty() || tokens[0][0] == '#') {
+            continue;
+        }
+        const std::string& keyword = tokens[0];
+        try {
+            if (ended) {
+                throw std::runtime_error("text after 'end'");
+            }
+            if (keyword == "job") {
+                if (tokens.size() != 2) {
+                    throw std::runtime_error("expected 'job <id>'");
+                }
+                job.id = tokens[1];
+            } else if (keyword == "timelimit") {
+                if (tokens.size() != 2) {
+                    throw std::runtime_error("expected 'timelimit <seconds>'");
+                }
+                job.timeLimit = parseNumber(tokens[1]);
+                if (!(job.timeLimit > 0.0)) {
+                    throw std::runtime_error("time limit must be positive");
+                }
+            } else if (keyword == "sense") {
+                if (tokens.size() != 2 || (tokens[1] != "min" && tokens[1] != "max")) {
+                    throw std::runtime_error("expected 'sense min|max'");
+                }
+                job.maximize = tokens[1] == "max";
+            } else if (keyword == "var") {
+                if (tokens.size() != 5 && !(tokens.size() == 6 && tokens[5] == "int")) {
+                    throw std::runtime_error("expected 'var <name> <lb> <ub> <obj> [int]'");
+                }
+                SolveJob::Variable variable;
+                variable.name = tokens[1];
+                variable.lb = parseNumber(tokens[2]);
+                variable.ub = parseNumber(tokens[3]);
+                variable.obj = parseNumber(tokens[4]);
+                variable.integer = tokens.size() == 6;
+                job.variables.push_back(std::move(variable));
+            } else if (keyword == "row") {
+                if (tokens.size() < 5) {
+                    throw std::runtime_error("expected 'row <name> <lhs> <rhs> <var>:<coef> ...'");
+                }
+                SolveJob::Row row;
+                row.name = tokens[1];
+                row.lhs = parseNumber(tokens[2]);
+                row.rhs = parseNumber(tokens[3]);
+                for (size_t t = 4; t < tokens.size(); ++t) {
+                    row.terms.push_back(parseTerm(tokens[t]));
+                }
+                job.rows.push_back(std::move(row));
+            } else if (keyword == "column") {
+                if (tokens.size() < 3) {
+                    throw std::runtime_error("expected 'column <cost> <row>:<coef> ...'");
+                }
+                SolveJob::PricedColumn column;
+                column.cost = parseNumber(tokens[1]);
+                for (size_t t = 2; t < tokens.size(); ++t) {
+                    column.entries.push_back(parseTerm(tokens[t]));
+                }
+                job.columns.push_back(std::move(column));
+            } else if (keyword == "pricing") {
+                for (size_t t = 1; t < tokens.size(); ++t) {
+                    const size_t eq = tokens[t].find('=');
+                    const std::string key = tokens[t].substr(0, eq);
+                    const std::string value = eq == std::string::npos ? "" : tokens[t].substr(eq + 1);
+                    if (key == "max_columns") {
+                        job.maxColumnsPerIteration = static_cast<int>(parseNumber(value));
+                    } else if (key == "tolerance") {
+                        job.reducedCostTolerance = parseNumber(value);
+                    } else {
+                        throw std::runtime_error("unknown pricing option '" + key + "'");
+                    }
+                }
+            } else if (keyword == "end") {
+                ended = true;
+            } else {
+                throw std::runtime_error("unknown keyword '" + keyword + "'");
+            }
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Line " + std::to_string(l + 1) + ": " + e.what());
+        }
+    }
+    if (job.id.empty()) {
+        throw std::runtime_error("Job without 'job <id>' line");
+    }
+    if (job.variables.empty() && job.columns.empty()) {
+        throw std::runtime_error("Job " + job.id + " has no variables");
+    }
+    if (!job.columns.empty() && job.maximize) {
+        throw std::runtime_error("Job " + job.id + ": column generation jobs must minimize");
+    }
+    return job;
+}
+
+JobResult SolveDaemon::execute(ScipSolver& solver, const SolveJob& job, SolverMetrics* metrics,
+                               const std::string& metricLabels) {
+    const auto start = std::chrono::steady_clock::now();
+    JobResult result;
+    result.id = job.id;
+
+    if (job.maximize) {
+        solver.setMaximize();
+    }
+
+    std::deque<ScipVariable> variables;     // Deque keeps the addresses stable
+    std::unordered_map<std::string, ScipVariable*> variableByName;
+    for (const SolveJob::Variable& v : job.variables) {
+        if (variableByName.count(v.name)) {
+            throw std::runtime_error("Duplicate variable '" + v.name + "'");
+        }
+        const double inf = SCIPinfinity(solver.get());
+        variables.push_back(solver.createVariable(v.name, std::max(v.lb, -inf), std::min(v.ub, inf),
+                                                  v.obj, v.integer ? SCIP_VARTYPE_INTEGER
+                                                                   : SCIP_VARTYPE_CONTINUOUS));
+        variableByName[v.name] = &variables.back();
+    }
+
+    std::deque<ScipConstraint> rows;
+    std::unordered_map<std::string, int> rowIndex;
+    std::vector<ScipConstraint*> rowPointers;
+    for (const SolveJob::Row& row : job.rows) {
+        std::vector<ScipVariable*> terms;
+        std::vector<double> coefficients;
+        for (const auto& term : row.terms) {
+            auto it = variableByName.find(term.first);
+            if (it == variableByName.end()) {
+                throw std::runtime_error("Row '" + row.name + "' uses unknown variable '"
+                                         + term.first + "'");
+            }
+            terms.push_back(it->second);
+            coefficients.push_back(term.second);
+        }
+        const double inf = SCIPinfinity(solver.get());
+        rows.push_back(solver.createConstraint(row.name, terms, coefficients,
+                                               std::max(row.lhs, -inf), std::min(row.rhs, inf)));
+        rowIndex[row.name] = static_cast<int>(rowPointers.size());
+        rowPointers.push_back(&rows.back());
+    }
+
+    auto collectValues = [&]() {
+        for (ScipVariable& variable : variables) {
+            const double value = variable.getSolutionValue();
+            if (value != 0.0) {
+                result.values.emplace_back(variable.getName(), value);
+            }
+        }
+    };
+
+    if (job.columns.empty()) {
+        solver.setTimeLimit(job.timeLimit);
+        solver.solve();
+        const SCIP_STATUS status = solver.getStatus();
+        result.status = statusName(status);
+        result.bound = solver.getDualBound();
+        if (SCIPgetNSols(solver.get()) > 0) {
+            result.objective = solver.getObjectiveValue();
+            collectValues();
+        } else {
+            result.objective = job.maximize ? -kInf : kInf;
+        }
+        result.seconds = secondsSince(start);
+        return result;
+    }
+
+    // Column generation: rows are the master, column lines the priceable store
+    ColumnStore store(static_cast<int>(rowPointers.size()));
+    std::vector<int> storeRows;
+    std::vector<double> storeValues;
+    for (const SolveJob::PricedColumn& column : job.columns) {
+        storeRows.clear();
+        storeValues.clear();
+        for (const auto& entry : column.entries) {
+            auto it = rowIndex.find(entry.first);
+            if (it == rowIndex.end()) {
+                throw std::runtime_error("Column uses unknown row '" + entry.first + "'");
+            }
+            storeRows.push_back(it->second);
+            storeValues.push_back(entry.second);
+        }
+        store.addColumn(column.cost, storeRows, storeValues);
+    }
+    ColumnStorePricer pricer(store, job.maxColumnsPerIteration, job.reducedCostTolerance);
+
+    solver.setColumnGenerationMode();
+    ColumnGeneration cg(solver, rowPointers);
+    cg.setMetrics(metrics, metricLabels);
+    cg.addOracle(&pricer);
+    ColumnGenerationParams params;
+    params.maxColumnsPerIteration = job.maxColumnsPerIteration;
+    params.reducedCostTolerance = job.reducedCostTolerance;
+    params.timeLimit = job.timeLimit - secondsSince(start);     // Setup counts against the job
+    const ColumnGenerationStats stats = cg.run(params);
+
+    result.status = stats.optimal ? "optimal"
+                  : secondsSince(start) >= job.timeLimit ? "timelimit" : "iterationlimit";
+    result.objective = stats.masterObjective;
+    result.bound = stats.lagrangianBound;
+    result.iterations = stats.iterations;
+    result.columnsAdded = stats.columnsAdded;
+    collectValues();
+    for (int j = 0; j < cg.getNumColumns(); ++j) {
+        const double value = cg.getColumn(j).getSolutionValue();
+        if (value != 0.0) {
+            result.values.emplace_back(cg.getColumn(j).getName(), value);
+        }
+    }
+    result.seconds = secondsSince(start);
+    return result;
+}
+
+std::vector<std::string> SolveDaemon::formatResult(const JobResult& result) {
+    std::vector<std::string> lines;
+    lines.push_back("result " + result.id + " status=" + result.status
+                    + " objective=" + formatNumber(result.objective)
+                    + " bound=" + formatNumber(result.bound)
+                    + " time=" + formatNumber(result.seconds)
+                    + " iterations=" + std::to_string(result.iterations)
+                    + " columns=" + std::to_string(result.columnsAdded));
+    for (const auto& value : result.values) {
+        lines.push_back("value " + result.id + " " + value.first + " " + formatNumber(value.second));
+    }
+    lines.push_back("done " + result.id);
+    return lines;
+}
+
+SolveDaemon::SolveDaemon(const std::string& socketPath, const DaemonParams& params)
+    : socketPath_(socketPath), params_(params), listenFd_(-1), stop_(false),
+      started_(std::chrono::steady_clock::now()), nextReader_(0), latencyNext_(0),
+      queueWaitTotal_(0.0) {
+    if (params_.numSolvers < 1) {
+        throw std::runtime_error("The daemon needs at least one solver");
+    }
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath_.empty() || socketPath_.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Invalid socket path '" + socketPath_ + "'");
+    }
+    std::strncpy(address.sun_path, socketPath_.c_str(), sizeof(address.sun_path) - 1);
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        throw std::runtime_error(std::string("socket() failed: ") + std::strerror(errno));
+    }
+    ::unlink(socketPath_.c_str());      // Stale socket of a previous run
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listenFd_, 64) != 0) {
+        const std::string error = std::strerror(errno);
+        ::close(listenFd_);
+        throw std::runtime_error("Cannot listen on '" + socketPath_ + "': " + error);
+    }
+
+    if (!params_.metricsPath.empty()) {
+        metrics_.reset(new SolverMetrics());
+        metricIds_.accepted = metrics_->addCounter("daemon_jobs_accepted_total", "Jobs queued");
+        metricIds_.rejected = metrics_->addCounter("daemon_jobs_rejected_total",
+                                                   "Jobs rejected with a full queue");
+        metricIds_.completed = metrics_->addCounter("daemon_jobs_completed_total", "Jobs solved");
+        metricIds_.failed = metrics_->addCounter("daemon_jobs_failed_total",
+                                                 "Jobs that could not be parsed or solved");
+        metricIds_.jobSeconds = metrics_->addCounter("daemon_job_seconds_total",
+                                                     "Submission to result seconds of completed jobs");
+        metricIds_.queued = metrics_->addGauge("daemon_queued_jobs", "Jobs waiting for a solver");
+        metricIds_.busy = metrics_->addGauge("daemon_busy_solvers", "Solvers running a job");
+        metrics_->start(params_.metricsPath, params_.metricsInterval);
+    }
+
+    // Plugins are included here, once per solver, not per job
+    for (int w = 0; w < params_.numSolvers; ++w) {
+        workers_.emplace_back(&SolveDaemon::workerLoop, this, w);
+    }
+}
+
+SolveDaemon::~SolveDaemon() {
+    stop();
+    queueReady_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    // Joined without the lock: finishing readers take it to report themselves
+    std::map<uint64_t, std::thread> readers;
+    {
+        std::lock_guard<std::mutex> lock(readersMutex_);
+        readers.swap(readers_);
+    }
+    for (auto& reader : readers) {
+        reader.second.join();
+    }
+    // Accepted jobs no solver took (readers may queue until they exit) still get a final line
+    for (PendingJob& pending : queue_) {
+        recordJob(secondsSince(pending.submitted), secondsSince(pending.submitted), true);
+        pending.connection->send({"error " + pending.job.id + " daemon shutting down"});
+    }
+    queue_.clear();
+    ::close(listenFd_);
+    ::unlink(socketPath_.c_str());
+}
+
+void SolveDaemon::stop() {
+    stop_.store(true);
+    queueReady_.notify_all();
+}
+
+void SolveDaemon::run() {
+    while (!stop_.load()) {
+        reapReaders();
+        pollfd entry{listenFd_, POLLIN, 0};
+        if (::poll(&entry, 1, 100) <= 0) {
+            continue;
+        }
+        const int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        auto connection = std::make_shared<Connection>(fd);
+        std::lock_guard<std::mutex> lock(readersMutex_);
+        const uint64_t id = nextReader_++;
+        readers_.emplace(id, std::thread([this, id, connection] {
+            serveConnection(connection);
+            std::lock_guard<std::mutex> doneLock(readersMutex_);
+            finishedReaders_.push_back(id);
+        }));
+    }
+}
+
+void SolveDaemon::reapReaders() {
+    std::vector<std::thread> finished;
+    {
+        std::lock_guard<std::mutex> lock(readersMutex_);
+        for (uint64_t id : finishedReaders_) {
+            auto reader = readers_.find(id);
+            finished.push_back(std::move(reader->second));
+            readers_.erase(reader);
+        }
+        finishedReaders_.clear();
+    }
+    // Outside the lock: a finished reader only has to return from its lambda
+    for (std::thread& reader : finished) {
+        reader.join();
+    }
+}
+
+void SolveDaemon::serveConnection(std::shared_ptr<Connection> connection) {
+    std::string buffer;
+    std::vector<std::string> block;
+    bool inJob = false;
+    char chunk[4096];
+
+    while (!stop_.load()) {
+        pollfd entry{connection->fd, POLLIN, 0};
+        if (::poll(&entry, 1, 100) <= 0) {
+            continue;
+        }
+        const ssize_t n = ::recv(connection->fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return;     // Client closed; queued jobs keep the connection object alive
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+
+        size_t newline;
+        while ((newline = buffer.find('\n')) != std::string::npos) {
+            std::string line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            const std::vector<std::string> tokens = tokenize(line);
+            if (tokens.empty()) {
+                continue;
+            }
+            if (inJob) {
+                block.push_back(line);
+                if (tokens[0] == "end") {
+                    handleBlock(connection, block);
+                    block.clear();
+                    inJob = false;
+                }
+            } else if (tokens[0] == "job") {
+                block.assign(1, line);
+                inJob = true;
+            } else if (tokens[0] == "stats") {
+                connection->send({formatStats()});
+            } else if (tokens[0] == "shutdown") {
+                connection->send({"bye"});
+                stop();
+                return;
+            } else if (tokens[0] == "quit") {
+                return;
+            } else {
+                connection->send({"error - unknown command '" + tokens[0] + "'"});
+            }
+        }
+    }
+}
+
+void SolveDaemon::handleBlock(const std::shared_ptr<Connection>& connection,
+                              const std::vector<std::string>& lines) {
+    const std::vector<std::string> header = tokenize(lines.front());
+    const std::string id = header.size() > 1 ? header[1] : "-";
+
+    PendingJob pending;
+    try {
+        pending.job = parseJob(lines);
+    } catch (const std::exception& e) {
+        connection->send({"error " + id + " " + e.what()});
+        if (metrics_) {
+            metrics_->add(metricIds_.failed, 1.0);
+        }
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        ++counters_.failed;
+        return;
+    }
+    if (std::isinf(pending.job.timeLimit)) {
+        pending.job.timeLimit = params_.defaultTimeLimit;
+    }
+    pending.connection = connection;
+    pending.submitted = std::chrono::steady_clock::now();
+
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (queue_.size() < params_.maxQueuedJobs) {
+            queue_.push_back(std::move(pending));
+            queued = true;
+        }
+        if (metrics_) {
+            metrics_->set(metricIds_.queued, static_cast<double>(queue_.size()));
+        }
+    }
+    if (metrics_) {
+        metrics_->add(queued ? metricIds_.accepted : metricIds_.rejected, 1.0);
+    }
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        ++(queued ? counters_.accepted : counters_.rejected);
+    }
+    if (!queued) {
+        connection->send({"rejected " + id + " queue full"});
+        return;
+    }
+    connection->send({"accepted " + id});
+    queueReady_.notify_one();
+}
+
+void SolveDaemon::workerLoop(int worker) {
+    ScipSolver solver("idle");
+    for (;;) {
+        PendingJob pending;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueReady_.wait(lock, [&] { return stop_.load() || !queue_.empty(); });
+            if (stop_.load()) {
+                return;
+            }
+            pending = std::move(queue_.front());
+            queue_.pop_front();
+            if (metrics_) {
+                metrics_->set(metricIds_.queued, static_cast<double>(queue_.size()));
+            }
+        }
+        const double queueWait = secondsSince(pending.submitted);
+        pending.connection->send({"started " + pending.job.id});
+
+        std::vector<std::string> lines;
+        bool failed = false;
+        if (metrics_) {
+            metrics_->add(metricIds_.busy, 1.0);
+        }
+        try {
+            solver.reset(pending.job.id);
+            solver.setVerbosity(0);
+            lines = formatResult(execute(solver, pending.job, metrics_.get(),
+                                        "solver=\"" + std::to_string(worker) + "\""));
+        } catch (const std::exception& e) {
+            lines = {"error " + pending.job.id + " " + e.what()};
+            failed = true;
+        }
+        if (metrics_) {
+            metrics_->add(metricIds_.busy, -1.0);
+        }
+        // Recorded first so a client reading "stats" after "done" sees this job
+        recordJob(secondsSince(pending.submitted), queueWait, failed);
+        pending.connection->send(lines);
+    }
+}
+
+void SolveDaemon::recordJob(double latency, double queueWait, bool failed) {
+    if (metrics_) {
+        metrics_->add(failed ? metricIds_.failed : metricIds_.completed, 1.0);
+        if (!failed) {
+            metrics_->add(metricIds_.jobSeconds, latency);
+        }
+    }
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    if (failed) {
+        ++counters_.failed;
+        return;
+    }
+    ++counters_.completed;
+    queueWaitTotal_ += queueWait;
+    counters_.maxLatency = std::max(counters_.maxLatency, latency);
+    if (latencies_.size() < params_.latencyWindow) {
+        latencies_.push_back(latency);
+    } else if (!latencies_.empty()) {
+        latencies_[latencyNext_] = latency;
+        latencyNext_ = (latencyNext_ + 1) % latencies_.size();
+    }
+}
+
+DaemonStats SolveDaemon::getStats() const {
+    std::vector<double> sorted;
+    DaemonStats stats;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats = counters_;
+        sorted = latencies_;
+        if (stats.completed > 0) {
+            stats.meanQueueWait = queueWaitTotal_ / static_cast<double>(stats.completed);
+        }
+    }
+    stats.uptime = secondsSince(started_);
+    stats.throughput = stats.uptime > 0.0 ? stats.completed / stats.uptime : 0.0;
+    if (!sorted.empty()) {
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0.0;
+        for (double latency : sorted) {
+            total += latency;
+        }
+        stats.meanLatency = total / static_cast<double>(sorted.size());
+        stats.p50Latency = sorted[(sorted.size() - 1) / 2];
+        stats.p95Latency = sorted[static_cast<size_t>(0.95 * (sorted.size() - 1))];
+    }
+    return stats;
+}
+
+std::string SolveDaemon::formatStats() const {
+    const DaemonStats stats = getStats();
+    size_t queued;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queued = queue_.size();
+    }
+    return "stats accepted=" + std::to_string(stats.accepted)
+           + " completed=" + std::to_string(stats.completed)
+           + " failed=" + std::to_string(stats.failed)
+           + " rejected=" + std::to_string(stats.rejected)
+           + " queued=" + std::to_string(queued)
+           + " uptime=" + formatNumber(stats.uptime)
+           + " throughput=" + formatNumber(stats.throughput)
+           + " latency_mean=" + formatNumber(stats.meanLatency)
+           + " latency_p50=" + formatNumber(stats.p50Latency)
+           + " latency_p95=" + formatNumber(stats.p95Latency)
+           + " latency_max=" + formatNumber(stats.maxLatency)
+           + " queue_wait_mean=" + formatNumber(stats.meanQueueWait);
+}
@@ -0,0 +1,164 @@
+#include "../include/solver_metrics.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+std::string formatValue(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+// Resident set size from /proc (0 where unavailable)
+double residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0;
+    long resident = 0;
+    if (!(statm >> pages >> resident)) {
+        return 0.0;
+    }
+    return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE));
+}
+
+} // namespace
+
+SolverMetrics::SolverMetrics(size_t capacity)
+    : capacity_(capacity), slots_(new Slot[capacity]), size_(0), stop_(false) {
+    if (capacity == 0) {
+        throw std::runtime_error("Solver metrics need at least one slot");
+    }
+    residentMemory_ = addGauge("process_resident_memory_bytes", "Resident memory size in bytes");
+}
+
+SolverMetrics::~SolverMetrics() {
+    try {
+        stop();
+    } catch (const std::exception&) {
+        // The last snapshot is lost; nothing to report it to
+    }
+}
+
+int SolverMetrics::registerMetric(const std::string& name, const std::string& help,
+                                  const std::string& labels, MetricType type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::string key = name + "{" + labels + "}";
+    auto known = index_.find(key);
+    if (known != index_.end()) {
+        if (info_[known->second].type != type) {
+            throw std::runtime_error("Metric '" + name + "' registered with two types");
+        }
+        return known->second;
+    }
+    if (info_.size() == capacity_) {
+        throw std::runtime_error("No free metric slot for '" + name + "'");
+    }
+    for (const Info& info : info_) {
+        if (info.name == name && info.type != type) {
+            throw std::runtime_error("Metric '" + name + "' registered with two types");
+        }
+    }
+    const int metric = static_cast<int>(info_.size());
+    info_.push_back({name, help, labels, type});
+    index_.emplace(key, metric);
+    slots_[metric].value.store(0.0, std::memory_order_relaxed);
+    size_.store(metric + 1, std::memory_order_release);
+    return metric;
+}
+
+int SolverMetrics::addCounter(const std::string& name, const std::string& help,
+                              const std::string& labels) {
+    return registerMetric(name, help, labels, MetricType::Counter);
+}
+
+int SolverMetrics::addGauge(const std::string& name, const std::string& help,
+                            const std::string& labels) {
+    return registerMetric(name, help, labels, MetricType::Gauge);
+}
+
+std::string SolverMetrics::format() {
+    set(residentMemory_, residentBytes());
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string text;
+    std::vector<char> done(info_.size(), 0);
+    for (size_t m = 0; m < info_.size(); ++m) {
+        if (done[m]) {
+            continue;
+        }
+        const Info& family = info_[m];
+        text += "# HELP " + family.name + " " + family.help + "\n";
+        text += "# TYPE " + family.name
+              + (family.type == MetricType::Counter ? " counter\n" : " gauge\n");
+        for (size_t k = m; k < info_.size(); ++k) {
+            if (done[k] || info_[k].name != family.name) {
+                continue;
+            }
+            done[k] = 1;
+            text += info_[k].name;
+            if (!info_[k].labels.empty()) {
+                text += "{" + info_[k].labels + "}";
+            }
+            text += " " + formatValue(get(static_cast<int>(k))) + "\n";
+        }
+    }
+    return text;
+}
+
+void SolverMetrics::writeFile(const std::string& path) {
+    const std::string text = format();
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        if (!out || !out.write(text.data(), static_cast<std::streamsize>(text.size()))) {
+            throw std::runtime_error("Cannot write metrics file '" + temporary + "'");
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace metrics file '" + path + "'");
+    }
+}
+
+void SolverMetrics::start(const std::string& path, double interval) {
+    if (writer_.joinable()) {
+        throw std::runtime_error("Metrics writer already running");
+    }
+    writeFile(path);
+    path_ = path;
+    stop_ = false;
+    writer_ = std::thread([this, interval] {
+        const auto period = std::chrono::duration<double>(interval);
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        while (!wake_.wait_for(lock, period, [this] { return stop_; })) {
+            lock.unlock();
+            try {
+                writeFile(path_);
+            } catch (const std::exception&) {
+                // Keep solving; the next period retries
+            }
+            lock.lock();
+        }
+    });
+}
+
+void SolverMetrics::stop() {
+    if (!writer_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    writer_.join();
+    writeFile(path_);
+}
@@ -0,0 +1,329 @@
+#include "../include/task_scheduler.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+thread_local const TaskScheduler* tlsScheduler = nullptr;
+thread_local int tlsWorker = -1;
+thread_local uint32_t tlsSeed = 0;
+
+uint32_t nextRandom(uint32_t& state) {
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+} // namespace
+
+// ChaseLevDeque
+
+ChaseLevDeque::ChaseLevDeque(int64_t capacity) : top_(0), bottom_(0) {
+    int64_t cap = 1;
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    buffers_.push_back(std::make_unique<Buffer>(cap));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+}
+
+void ChaseLevDeque::push(Task* task) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    if (b - t > buffer->capacity - 1) {
+        // Full: copy the live range into a buffer twice as large
+        buffers_.push_back(std::make_unique<Buffer>(buffer->capacity * 2));
+        Buffer* grown = buffers_.back().get();
+        for (int64_t i = t; i < b; ++i) {
+            grown->put(i, buffer->get(i));
+        }
+        buffer_.store(grown, std::memory_order_release);
+        buffer = grown;
+    }
+    buffer->put(b, task);
+    bottom_.store(b + 1, std::memory_order_release);
+}
+
+Task* ChaseLevDeque::take() {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+
+    Task* task = nullptr;
+    if (t <= b) {
+        task = buffer->get(b);
+        if (t == b) {
+            // Last element: race against thieves
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                task = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+    } else {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+Task* ChaseLevDeque::steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+        return nullptr;
+    }
+    Buffer* buffer = buffer_.load(std::memory_order_acquire);
+    Task* task = buffer->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return task;
+}
+
+bool ChaseLevDeque::isEmpty() const {
+    return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+}
+
+// TaskScheduler
+
+TaskScheduler::TaskScheduler(const SchedulerParams& params)
+    : params_(params), topology_(NumaTopology::detect()) {
+    int numThreads = params_.numThreads;
+    if (numThreads <= 0) {
+        numThreads = topology_.getNumCpus();
+    }
+
+    for (int i = 0; i < numThreads; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->cpu = topology_.getCpuForWorker(i);
+        worker->node = std::max(0, topology_.getNodeOfCpu(worker->cpu));
+        workers_.push_back(std::move(worker));
+    }
+
+    // Steal from the own node first, then from the others
+    for (int i = 0; i < numThreads; ++i) {
+        auto& victims = workers_[i]->victims;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int j = 0; j < numThreads; ++j) {
+                const bool sameNode = workers_[j]->node == workers_[i]->node;
+                if (j != i && sameNode == (pass == 0)) {
+                    victims.push_back(j);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < numThreads; ++i) {
+        workers_[i]->thread = std::thread(&TaskScheduler::workerLoop, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_.store(true);
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    // Tasks nobody waited for
+    for (auto& worker : workers_) {
+        for (auto& deque : worker->deques) {
+            while (Task* task = deque.steal()) {
+                delete task;
+            }
+        }
+    }
+    for (auto& queue : injected_) {
+        for (Task* task : queue) {
+            delete task;
+        }
+    }
+}
+
+TaskScheduler& TaskScheduler::shared() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+int TaskScheduler::getCurrentWorker() const {
+    return tlsScheduler == this ? tlsWorker : -1;
+}
+
+void TaskScheduler::submit(TaskGroup& group, std::function<void()> function,
+                           TaskPriority priority) {
+    const int level = static_cast<int>(priority);
+    Task* task = new Task{std::move(function), &group};
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+
+    const int worker = getCurrentWorker();
+    if (worker >= 0) {
+        workers_[worker]->deques[level].push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(injectMutex_);
+        injected_[level].push_back(task);
+        injectedCount_.fetch_add(1, std::memory_order_release);
+    }
+
+    queued_.fetch_add(1);
+    if (sleepers_.load() > 0) {
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        wake_.notify_one();
+    }
+}
+
+Task* TaskScheduler::stealFrom(int thief, const std::vector<int>& victims, int priority) {
+    if (victims.empty()) {
+        return nullptr;
+    }
+    // Random start within the candidate list spreads thieves over victims
+    if (tlsSeed == 0) {
+        tlsSeed = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+    }
+    const size_t start = nextRandom(tlsSeed) % victims.size();
+    for (size_t k = 0; k < victims.size(); ++k) {
+        const int victim = victims[(start + k) % victims.size()];
+        if (Task* task = workers_[victim]->deques[priority].steal()) {
+            if (thief >= 0) {
+                workers_[thief]->stolen.fetch_add(1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+Task* TaskScheduler::findTask(int worker) {
+    static thread_local std::vector<int> everyone;
+    if (worker < 0 && everyone.size() != workers_.size()) {
+        everyone.resize(workers_.size());
+        for (size_t i = 0; i < everyone.size(); ++i) {
+            everyone[i] = static_cast<int>(i);
+        }
+    }
+
+    for (int level = 0; level < 3; ++level) {
+        if (worker >= 0) {
+            if (Task* task = workers_[worker]->deques[level].take()) {
+                return task;
+            }
+        }
+        if (injectedCount_.load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> lock(injectMutex_);
+            if (!injected_[level].empty()) {
+                Task* task = injected_[level].front();
+                injected_[level].pop_front();
+                injectedCount_.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        if (Task* task = stealFrom(worker, worker >= 0 ? workers_[worker]->victims : everyone, level)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void TaskScheduler::run(Task* task) {
+    queued_.fetch_sub(1);
+    try {
+        task->function();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(task->group->errorMutex_);
+        if (!task->group->error_) {
+            task->group->error_ = std::current_exception();
+        }
+    }
+    TaskGroup* group = task->group;
+    delete task;
+    group->pending_.fetch_sub(1, std::memory_order_release);
+}
+
+void TaskScheduler::workerLoop(int index) {
+    tlsScheduler = this;
+    tlsWorker = index;
+    Worker& self = *workers_[index];
+    if (params_.pinThreads) {
+        pinCurrentThreadToCpu(self.cpu);
+    }
+
+    int idleRounds = 0;
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (Task* task = findTask(index)) {
+            run(task);
+            self.executed.fetch_add(1, std::memory_order_relaxed);
+            idleRounds = 0;
+            continue;
+        }
+        if (++idleRounds < params_.spinRounds) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Sleep until something is queued; sleepers_ and queued_ are both seq_cst so a
+        // concurrent submit either sees the sleeper or the sleeper sees the task
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepers_.fetch_add(1);
+        wake_.wait(lock, [&] { return stop_.load() || queued_.load() > 0; });
+        sleepers_.fetch_sub(1);
+        idleRounds = 0;
+    }
+}
+
+void TaskScheduler::wait(TaskGroup& group) {
+    const int worker = getCurrentWorker();
+    while (!group.isDone()) {
+        if (Task* task = findTask(worker)) {
+            run(task);
+            if (worker >= 0) {
+                workers_[worker]->executed.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(group.errorMutex_);
+        std::swap(error, group.error_);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void TaskScheduler::parallelFor(size_t begin, size_t end, size_t grain,
+                                const std::function<void(size_t, size_t)>& body,
+                                TaskPriority priority) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    TaskGroup group;
+    for (size_t chunk = begin; chunk < end; chunk += grain) {
+        const size_t chunkEnd = std::min(end, chunk + grain);
+        submit(group, [&body, chunk, chunkEnd] { body(chunk, chunkEnd); }, priority);
+    }
+    wait(group);
+}
+
+SchedulerStats TaskScheduler::getStats() const {
+    SchedulerStats stats;
+    for (const auto& worker : workers_) {
+        stats.executed += worker->executed.load(std::memory_order_relaxed);
+        stats.stolen += worker->stolen.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
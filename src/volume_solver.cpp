@@ -0,0 +1,120 @@
+#include "../include/volume_solver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+VolumeSolver::VolumeSolver(ScipSolver& solver,
+                           const std::vector<ScipConstraint*>& rows,
+                           const std::vector<ScipVariable*>& columns,
+                           const VolumeParams& params)
+    : relaxation_(solver, rows, columns), params_(params) {}
+
+namespace {
+
+double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+} // namespace
+
+LagrangianSolution VolumeSolver::solve(const std::vector<double>& initialDuals) {
+    const int numRows = relaxation_.getNumRows();
+    const double sense = relaxation_.getSense();
+
+    // 1. Start from the given duals (or zero) and the corresponding Lagrangian minimizer
+    std::vector<double> center = initialDuals.empty()
+        ? std::vector<double>(numRows, 0.0)
+        : relaxation_.fromModelSense(initialDuals);
+    relaxation_.projectDuals(center);
+
+    std::vector<double> xBar;
+    double bestValue = relaxation_.evaluate(center, xBar);
+    double target = bestValue + params_.targetGap * std::max(std::fabs(bestValue), 1.0);
+
+    std::vector<double> trial(numRows);
+    std::vector<double> xTrial;
+    std::vector<double> direction;   // Subgradient at the averaged primal point
+    std::vector<double> trialDir;    // Subgradient at the trial minimizer
+
+    double stepFactor = params_.stepFactor;
+    int redSteps = 0;
+
+    LagrangianSolution result;
+    for (result.iterations = 0; result.iterations < params_.maxIterations; ++result.iterations) {
+        // 2. Convergence: averaged primal nearly feasible and close to the bound
+        relaxation_.subgradient(center, xBar, direction);
+        const double primalValue = sense * relaxation_.primalObjective(xBar);
+        const double gap = std::fabs(primalValue - bestValue) / std::max(std::fabs(bestValue), 1.0);
+        if (relaxation_.maxViolation(xBar) <= params_.primalTolerance && gap <= params_.gapTolerance) {
+            result.converged = true;
+            break;
+        }
+
+        double norm2 = dot(direction, direction);
+        if (norm2 <= 0.0) {
+            // Averaged primal is exactly feasible: fall back to the center's own subgradient
+            relaxation_.evaluate(center, xTrial);
+            relaxation_.subgradient(center, xTrial, direction);
+            norm2 = dot(direction, direction);
+            if (norm2 <= 0.0) {
+                result.converged = true;  // Zero subgradient: the center is optimal
+                break;
+            }
+        }
+
+        // 3. Step from the center along the volume direction
+        const double step = stepFactor * (target - bestValue) / norm2;
+        for (int i = 0; i < numRows; ++i) {
+            trial[i] = center[i] + step * direction[i];
+        }
+        relaxation_.projectDuals(trial);
+        const double trialValue = relaxation_.evaluate(trial, xTrial);
+
+        // 4. Averaging weight minimizing the norm of the combined subgradient
+        relaxation_.subgradient(trial, xTrial, trialDir);
+        double alpha = params_.alphaMax;
+        double diffNorm2 = 0.0;
+        double cross = 0.0;
+        for (int i = 0; i < numRows; ++i) {
+            const double diff = direction[i] - trialDir[i];
+            diffNorm2 += diff * diff;
+            cross += direction[i] * diff;
+        }
+        if (diffNorm2 > 0.0) {
+            alpha = std::min(params_.alphaMax, std::max(params_.alphaMax / 10.0, cross / diffNorm2));
+        }
+        for (size_t j = 0; j < xBar.size(); ++j) {
+            xBar[j] = alpha * xTrial[j] + (1.0 - alpha) * xBar[j];
+        }
+
+        // 5. Classify the step: green/yellow move the center, red steps shrink lambda
+        if (trialValue > bestValue) {
+            if (dot(trialDir, direction) >= 0.0) {
+                stepFactor = std::min(2.0, stepFactor * 1.1);
+            }
+            center.swap(trial);
+            bestValue = trialValue;
+            redSteps = 0;
+        } else if (++redSteps >= params_.redStepLimit) {
+            stepFactor = std::max(params_.minStepFactor, stepFactor * 0.66);
+            redSteps = 0;
+        }
+
+        if (bestValue >= target - 0.5 * params_.targetGap * std::max(std::fabs(target), 1.0)) {
+            target = bestValue + params_.targetGap * std::max(std::fabs(bestValue), 1.0);
+        }
+    }
+
+    // 6. Report in the model's objective sense
+    relaxation_.toModelSense(center);
+    result.duals = std::move(center);
+    result.primal = std::move(xBar);
+    result.dualBound = sense * bestValue;
+    result.primalObjective = relaxation_.primalObjective(result.primal);
+    result.maxViolation = relaxation_.maxViolation(result.primal);
+    return result;
+}